@@ -0,0 +1,141 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <sstream>
+# include <algorithm>
+# include "../rhsODEproblem.H"
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../Ensemble/EnsembleSolver.H"
+# include "../Output/Trajectory.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : parameter sweep on the lorentz attractor
+ *                  (rho in [20 , 30] , M members)
+ *
+ *      one RungeKutta4Solver per member (copy of the problem ,
+ *      one member at a time) vs EnsembleSolver : SoA batches of
+ *      lanes members , single thread and work stealing pool ,
+ *      fixed step RK4 and adaptive Dormand-Prince 5(4)
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+//-- SoA batch : u[i*L + l] , p = (sigma , rho , beta)
+auto lorentzBatch = [](const double t , const double* u , double* dudt , const double* p , const std::size_t L)
+                    {
+                       const double* x = u ;      const double* y = u + L ;  const double* z = u + 2*L ;
+                       const double* s = p ;      const double* r = p + L ;  const double* b = p + 2*L ;
+                       for(std::size_t l=0 ; l < L ; l++)
+                       {
+                          dudt[l]       = s[l] * (y[l] - x[l]) ;
+                          dudt[L + l]   = x[l] * (r[l] - z[l]) - y[l] ;
+                          dudt[2*L + l] = x[l] * y[l] - b[l] * z[l] ;
+                       }
+                    };
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+int main(){
+
+   const std::size_t M  = 4096 ;
+   const double      t0 = 0.0 ;
+   const double      tf = 10.0 ;
+   const double      dt = 0.01 ;
+
+   EnsembleProblem<double> sweep(lorentzBatch , 3 , 3 , t0 , tf , dt) ;
+   for(std::size_t m=0 ; m < M ; m++)
+      sweep.add({1.0 , 0.0 , 0.0} , {10.0 , 20.0 + 10.0*m/(M-1) , 8.0/3.0}) ;
+
+   //-- reference : one solver per member
+   std::vector<double> single(M*3) ;
+   std::stringstream quiet ;
+   auto* coutBuf = cout.rdbuf(quiet.rdbuf()) ;
+   const double tSingle = timeIt([&](){
+        for(std::size_t m=0 ; m < M ; m++)
+        {
+           const double rho = 20.0 + 10.0*m/(M-1) ;
+           rhsODEProblem<double> p([rho](const double t , const double* y , double* dydt)
+                                   {
+                                      dydt[0] = 10.0 * (y[1] - y[0]) ;
+                                      dydt[1] = y[0] * (rho - y[2]) - y[1] ;
+                                      dydt[2] = y[0] * y[1] - 8.0/3.0 * y[2] ;
+                                   } , t0 , tf , dt , {1.0 , 0.0 , 0.0}) ;
+           RungeKutta4Solver<double> rk4(p) ;
+           rk4.observe([&](const double t , const double* u , const std::size_t n)
+                       { std::copy(u , u + n , &single[m*3]) ; }) ;
+        }
+   });
+   cout.rdbuf(coutBuf) ;
+
+   cout << setw(36) << "run" << setw(12) << "time[s]" << setw(12) << "speedup" << setw(14) << "max |diff|" << endl ;
+   cout << setw(36) << "RungeKutta4Solver x M" << setw(12) << tSingle << setw(12) << 1.0 << endl ;
+
+   auto report = [&](const string& name , auto& ens , const double time , const bool compare)
+                 {
+                    double diff = 0.0 ;
+                    for(std::size_t i=0 ; compare && i < M*3 ; i++)
+                       diff = std::max(diff , std::abs(ens.finalStates()[i] - single[i])) ;
+                    cout << setw(36) << name << setw(12) << time << setw(12) << tSingle/time ;
+                    if( compare ) cout << setw(14) << diff ;
+                    cout << endl ;
+                 };
+
+   const std::size_t cores = std::max(1u , std::thread::hardware_concurrency()) ;
+
+   for(const std::size_t lanes : { std::size_t(1) , std::size_t(8) , std::size_t(16) })
+      for(const std::size_t threads : { std::size_t(0) , cores })
+      {
+         EnsembleSolver<double , RungeKutta4Tableau> ens(sweep , lanes , threads) ;
+         cout.rdbuf(quiet.rdbuf()) ;
+         const double time = timeIt([&](){ ens.solve() ; }) ;
+         cout.rdbuf(coutBuf) ;
+         report("ensemble RK4 lanes " + to_string(lanes) + " threads " + to_string(threads) , ens , time , true) ;
+      }
+
+   EnsembleSolver<double , DormandPrince5Tableau> dp5(sweep , 8 , cores) ;
+   dp5.setTolerances(1.0e-8 , 1.0e-8) ;
+   cout.rdbuf(quiet.rdbuf()) ;
+   const double tDp5 = timeIt([&](){ dp5.solve() ; }) ;
+   cout.rdbuf(coutBuf) ;
+   report("ensemble DP5(4) adaptive lanes 8" , dp5 , tDp5 , false) ;
+   cout << "   batch steps " << dp5.accepted() << " , rejected " << dp5.rejected() << endl ;
+
+   //-- reductions at tf
+   EnsembleSolver<double , RungeKutta4Tableau> ens(sweep , 8 , cores) ;
+   ens.solve() ;
+   const auto mu  = ens.mean() ;
+   const auto var = ens.variance() ;
+   cout << "mean(tf)     " << mu[0]  << " " << mu[1]  << " " << mu[2]  << endl ;
+   cout << "variance(tf) " << var[0] << " " << var[1] << " " << var[2] << endl ;
+
+   //-- one trajectory per member : first 4 members kept in memory
+   std::vector<Trajectory<double>> kept(4) ;
+   EnsembleProblem<double> few(lorentzBatch , 3 , 3 , t0 , tf , dt) ;
+   for(std::size_t m=0 ; m < kept.size() ; m++)
+      few.add({1.0 , 0.0 , 0.0} , {10.0 , 20.0 + 2.0*m , 8.0/3.0}) ;
+   EnsembleSolver<double , RungeKutta4Tableau> small(few , 8 , 2) ;
+   small.solve([&](const std::size_t m) { return std::unique_ptr<OutputSink<double>>(new TrajectorySink<double>(kept[m])) ; }) ;
+   for(std::size_t m=0 ; m < kept.size() ; m++)
+      cout << "member " << m << " records " << kept[m].size() << " x(tf) " << kept[m](kept[m].size()-1 , 0) << endl ;
+
+  return 0;
+}
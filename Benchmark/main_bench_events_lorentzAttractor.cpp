@@ -0,0 +1,139 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <fstream>
+# include <sstream>
+# include <cstdio>
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../rhsODEproblem.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : Poincare section z = 27 (rising) of the lorentz
+ *      attractor , RK4 dt = 1e-3 up to t = 200 (start on the attractor)
+ *
+ *      --> offline   : solve(filename) , then the text file is read
+ *                      back and searched for the sign changes
+ *                      (linear interpolation between the records)
+ *      --> events    : addEvent + setEventsOnly , only the crossings
+ *                      written
+ *      --> terminate : section until z first reaches 45 (threshold)
+ *
+ *      time , bytes written , crossings
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto lorentz =[](const double , const double* y , double* dydt)
+              {
+                 dydt[0] =  10.0 * (y[1] - y[0]) ;
+                 dydt[1] =  28.0 * y[0] - y[1] - y[0] * y[2] ;
+                 dydt[2] = -8.0/3.0 * y[2] + y[0]* y[1] ;
+              };
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+std::size_t fileSize(const std::string& name)
+{
+   std::ifstream f(name , std::ios::binary | std::ios::ate) ;
+   return f ? std::size_t(f.tellg()) : 0 ;
+}
+
+
+void report(const string& what , const double time , const std::size_t bytes , const std::size_t crossings)
+{
+   cout << setw(12) << left << what << right << setw(12) << time << setw(14) << bytes
+        << setw(12) << crossings << endl ;
+}
+
+
+int main(){
+
+   const rhsODEProblem<double> p(lorentz , 0.0 , 200.0 , 1.0e-3 , {-8.0 , 8.0 , 27.0}) ;
+   const auto plane = [](const double , const double* y){ return y[2] - 27.0 ; } ;
+
+   cout << setw(12) << left << "run" << right << setw(12) << "time s" << setw(14) << "bytes"
+        << setw(12) << "crossings" << endl ;
+
+   std::streambuf* console = cout.rdbuf(nullptr) ;
+
+   //-- offline
+   std::size_t offline = 0 ;
+   const std::string dump = "events_lorentz.txt" ;
+   const double a = timeIt([&]()
+   {
+      RungeKutta4Solver<double> s(p) ;
+      s.solve(dump) ;
+
+      std::ifstream f(dump) ;
+      std::string line ;
+      double t , x , y , z , zOld = 0 ;
+      bool first = true ;
+      while( std::getline(f , line) )
+      {
+         std::istringstream in(line) ;
+         if( !(in >> t >> x >> y >> z) ) continue ;
+         if( !first && zOld < 27.0 && z >= 27.0 ) offline++ ;
+         zOld  = z ;
+         first = false ;
+      }
+   }) ;
+   const std::size_t bytes = fileSize(dump) ;
+   std::remove(dump.c_str()) ;
+
+   //-- events only
+   const std::string section = "events_lorentz_section.txt" ;
+   std::size_t events = 0 ;
+   const double b = timeIt([&]()
+   {
+      RungeKutta4Solver<double> s(p) ;
+      s.addEvent(plane , EventDirection::rising) ;
+      s.setEventsOnly(true) ;
+      s.solve(section) ;
+      events = s.events().size() ;
+   }) ;
+   const std::size_t sectionBytes = fileSize(section) ;
+   std::remove(section.c_str()) ;
+
+   //-- terminate at the threshold
+   std::size_t before = 0 ;
+   double      stop   = 0 ;
+   const double c = timeIt([&]()
+   {
+      RungeKutta4Solver<double> s(p) ;
+      s.addEvent(plane , EventDirection::rising) ;
+      s.addEvent([](const double , const double* y){ return y[2] - 45.0 ; } ,
+                 EventDirection::rising , EventAction::terminate) ;
+      s.setEventsOnly(true) ;
+      NullSink<double> out ;
+      s.solve(out) ;
+      before = s.events().size() - 1 ;
+      stop   = s.events().back().t ;
+   }) ;
+
+   cout.rdbuf(console) ;
+
+   report("offline"   , a , bytes , offline) ;
+   report("events"    , b , sectionBytes , events) ;
+   report("terminate" , c , 0 , before) ;
+   cout << endl << "z = 45 at t = " << stop << " of 200" << endl ;
+
+   return 0 ;
+}
@@ -0,0 +1,83 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <valarray>
+# include <algorithm>
+# include "../Kernels/LinearCombination.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : stage combination  y = u + h (b1 k1 + ... + b4 k4)
+ *                  (last update of the classic RungeKutta 4th)
+ *
+ *      valarray expression (temporaries) vs fused kernel ,
+ *      scalar / avx2 / avx512 selected at runtime
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+template <typename Function>
+double timeIt(Function&& fun , const std::size_t repeat)
+{
+   const auto start = std::chrono::steady_clock::now();
+   for(std::size_t r=0 ; r < repeat ; r++)
+      fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count() / repeat ;
+}
+
+
+int main(){
+
+   const double h = 1.0e-3 ;
+
+   cout << "detected isa : " << kernel::isaName(kernel::detectIsa()) << endl ;
+   cout << setw(10) << "n" << setw(14) << "valarray[ns]" ;
+   for(const auto i : { kernel::Isa::scalar , kernel::Isa::avx2 , kernel::Isa::avx512 })
+      cout << setw(14) << (string(kernel::isaName(i)) + "[ns]") ;
+   cout << setw(12) << "max |diff|" << endl ;
+
+   for(const std::size_t n : { std::size_t(1000) , std::size_t(10000) , std::size_t(100000) , std::size_t(1000000) })
+   {
+      std::valarray<double> u(n) , y(n) , k1(n) , k2(n) , k3(n) , k4(n) ;
+      for(std::size_t i=0 ; i < n ; i++)
+      {
+         u[i]  = std::sin(0.001*i) ;
+         k1[i] = std::cos(0.002*i) ;  k2[i] = std::cos(0.003*i) ;
+         k3[i] = std::cos(0.005*i) ;  k4[i] = std::cos(0.007*i) ;
+      }
+      const std::size_t repeat = std::max(std::size_t(10) , std::size_t(20000000) / n) ;
+
+      std::valarray<double> ref(n) ;
+      const double tv = timeIt([&](){ ref = u + h/6 * (k1 + k4) + h/3 * (k2 + k3) ; } , repeat) ;
+      cout << setw(10) << n << setw(14) << 1.0e12 * tv / n ;
+
+      double diff = 0.0 ;
+      for(const auto i : { kernel::Isa::scalar , kernel::Isa::avx2 , kernel::Isa::avx512 })
+      {
+         kernel::setIsa(i) ;
+         if( kernel::isa() != i )
+         {
+            cout << setw(14) << "-" ;
+            continue ;
+         }
+         const double tk = timeIt([&](){ kernel::combine(y , u , h/6 , k1 , h/3 , k2 , h/3 , k3 , h/6 , k4) ; } , repeat) ;
+         cout << setw(14) << 1.0e12 * tk / n ;
+         diff = std::max(diff , std::abs(y - ref).max()) ;
+      }
+      kernel::setIsa(kernel::detectIsa()) ;
+      cout << setw(12) << diff << endl ;
+   }
+   cout << "(time per 1000 components)" << endl ;
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <memory>
+# include <thread>
+# include <algorithm>
+# include "../rhsODEproblem.H"
+# include "../Euler/BackwardEulerSolver.H"
+# include "../Implicit/DenseLinearSolver.H"
+# include "../Implicit/BandedLinearSolver.H"
+# include "../Implicit/SparseLinearSolver.H"
+# include "../Implicit/MatrixFreeLinearSolver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : linear solver backends of the Newton iteration
+ *
+ *      backward Euler , 20 steps , on the 1D heat equation with a
+ *      cubic source (method of lines , n = 500 .. 10^6) and on the
+ *      2D one (5 point , n = 10^4 .. 10^5)
+ *
+ *      time , values held by the backend / n , rhs evaluations ,
+ *      GMRES iterations , serial and with a pool of all the cores
+ *      (the dense LU up to n = 2000 only : 2 n^2 values ; the matrix
+ *      free GMRES has no preconditioner , h^2 stiffness stops it at
+ *      n = 10^4 in 1D)
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+//-- m points per side , u_t = lap(u) / h^2 + u - u^3 , zero boundary values
+rhsODEProblem<double> heat(const std::size_t m , const int dim)
+{
+   const std::size_t n = dim == 1 ? m : m*m ;
+   const double      h = 1.0 / (m + 1) ;
+   const double      c = 1.0 / (h*h) ;
+
+   std::valarray<double> u0(n) ;
+   for(std::size_t i=0 ; i < n ; i++)
+      u0[i] = std::sin(M_PI * ((dim == 1 ? i : i % m) + 1) * h) ;
+
+   rhsODEProblem<double> p([m , n , c , dim](const double , const double* u , double* dudt)
+                           {
+                              for(std::size_t i=0 ; i < n ; i++)
+                              {
+                                 const std::size_t a = dim == 1 ? i : i % m ;
+                                 double lap = -2.0 * dim * u[i] ;
+                                 if( a > 0 )     lap += u[i-1] ;
+                                 if( a + 1 < m ) lap += u[i+1] ;
+                                 if( dim == 2 && i >= m )    lap += u[i-m] ;
+                                 if( dim == 2 && i + m < n ) lap += u[i+m] ;
+                                 dudt[i] = c * lap + u[i] - u[i]*u[i]*u[i] ;
+                              }
+                           } , 0.0 , 2.0e-3 , 1.0e-4 , u0) ;
+
+   std::vector<std::vector<std::size_t>> rows(n) ;
+   for(std::size_t i=0 ; i < n ; i++)
+   {
+      const std::size_t a = dim == 1 ? i : i % m ;
+      rows[i] = {i} ;
+      if( a > 0 )     rows[i].push_back(i-1) ;
+      if( a + 1 < m ) rows[i].push_back(i+1) ;
+      if( dim == 2 && i >= m )    rows[i].push_back(i-m) ;
+      if( dim == 2 && i + m < n ) rows[i].push_back(i+m) ;
+   }
+   p.setSparsity(rows) ;
+   return p ;
+}
+
+
+void run(const string& name , const rhsODEProblem<double>& p , LinearSolver<double>&& backend ,
+         const std::shared_ptr<WorkStealingPool>& pool)
+{
+   double serial = 0 , parallel = 0 ;
+   std::size_t values = 0 , rhs = 0 , linear = 0 ;
+
+   for(int pass=0 ; pass < 2 ; pass++)
+   {
+      backend.setPool(pass ? pool : nullptr) ;
+      BackwardEulerSolver<double> be(p) ;
+      be.nonlinearSolver().setLinearSolver(backend) ;
+
+      std::streambuf* console = cout.rdbuf(nullptr) ;
+      const double time = timeIt([&](){ be.observe([](const double , const double* , const std::size_t){}) ; }) ;
+      cout.rdbuf(console) ;
+
+      (pass ? parallel : serial) = time ;
+      values = be.nonlinearSolver().linearSolver().storage() ;
+      rhs    = be.statistics().rhsEvaluations ;
+      linear = be.statistics().linearIterations ;
+   }
+
+   cout << setw(24) << left << name << right << setw(10) << p.u0().size()
+        << setw(12) << double(values) / p.u0().size() << setw(10) << rhs << setw(10) << linear
+        << setw(12) << serial << setw(12) << parallel << setw(10) << serial / parallel << endl ;
+}
+
+
+int main(){
+
+   const auto pool = std::make_shared<WorkStealingPool>(std::max(1u , std::thread::hardware_concurrency())) ;
+   cout << "workers " << pool->size() << endl << endl ;
+
+   cout << setw(24) << left << "backend" << right << setw(10) << "n" << setw(12) << "values/n"
+        << setw(10) << "rhs" << setw(10) << "gmres" << setw(12) << "serial s" << setw(12) << "pool s"
+        << setw(10) << "speedup" << endl ;
+
+   using Sparse = SparseLinearSolver<double> ;
+
+   for(std::size_t m : {500 , 2000 , 10000 , 100000 , 1000000})
+   {
+      const auto p = heat(m , 1) ;
+      if( m <= 2000 )
+         run("1D dense LU" , p , DenseLinearSolver<double>() , pool) ;
+      run("1D banded LU" , p , BandedLinearSolver<double>(1 , 1) , pool) ;
+      run("1D sparse LU" , p , Sparse(Sparse::Method::direct) , pool) ;
+      run("1D ILU(0) GMRES" , p , Sparse(Sparse::Method::gmres) , pool) ;
+      if( m <= 10000 )
+         run("1D matrix free GMRES" , p , MatrixFreeLinearSolver<double>() , pool) ;
+      cout << endl ;
+   }
+
+   for(std::size_t m : {100 , 316})
+   {
+      const auto p = heat(m , 2) ;
+      if( m <= 100 )
+      {
+         run("2D banded LU" , p , BandedLinearSolver<double>(m , m) , pool) ;
+         run("2D sparse LU" , p , Sparse(Sparse::Method::direct) , pool) ;
+      }
+      run("2D ILU(0) GMRES" , p , Sparse(Sparse::Method::gmres) , pool) ;
+      run("2D matrix free GMRES" , p , MatrixFreeLinearSolver<double>() , pool) ;
+      cout << endl ;
+   }
+
+   return 0 ;
+}
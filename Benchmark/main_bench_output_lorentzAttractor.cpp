@@ -0,0 +1,98 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <fstream>
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../Output/BinarySink.H"
+# include "../Output/DecimatedSink.H"
+# include "../Output/AsyncSink.H"
+# include "../rhsODEproblem.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : trajectory output of the lorentz attractor (RK4)
+ *
+ *      std::endl per step (the old solvers output) vs the sinks :
+ *      buffered text , binary , async text , every 10th step , null
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto lorentz =[](const double t , const double* y , double* dydt)
+              {
+                 dydt[0] =  10.0 * (y[1] - y[0]) ;
+                 dydt[1] =  28.0 * y[0] - y[1] - y[0] * y[2] ;
+                 dydt[2] = -8.0/3.0 * y[2] + y[0]* y[1] ;
+              };
+
+
+//-- the old output : operator<< and std::endl on every step
+template <typename Type>
+class EndlSink : public OutputSink<Type>
+{
+   public:
+      explicit EndlSink(const std::string& filename) : f(filename , std::ios::out) {}
+
+      using OutputSink<Type>::n ;
+
+      void write(const Type t , const Type* u) override
+      {
+         f << t << ' ' ;
+         for(std::size_t i=0 ; i < n ; i++)
+            f << u[i] << " " ;
+         f << std::endl ;
+      }
+
+   private:
+      std::ofstream f ;
+};
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+int main(){
+
+   const double t0 = 0.0;
+   const double tf = 100.0 ;
+   const double dt = 0.0001;
+   const std::valarray<double> u0 = {1.0,0.0,0.0} ;
+
+   rhsODEProblem<double> problem(lorentz , t0, tf , dt, u0 );
+   RungeKutta4Solver<double> rk4(problem);
+
+
+   const double tEndl  = timeIt([&](){ EndlSink<double>   f("lorentz_endl.out");   rk4.solve(f); });
+   const double tText  = timeIt([&](){ TextSink<double>   f("lorentz_text.out");   rk4.solve(f); });
+   const double tBin   = timeIt([&](){ BinarySink<double> f("lorentz_binary.bin"); rk4.solve(f); });
+   const double tAsync = timeIt([&](){ TextSink<double>   f("lorentz_async.out");
+                                       AsyncSink<double>  a(f);                    rk4.solve(a); });
+   const double tDec   = timeIt([&](){ TextSink<double>   f("lorentz_every10.out");
+                                       DecimatedSink<double> d(f , 10);            rk4.solve(d); });
+   const double tNull  = timeIt([&](){ NullSink<double>   f;                       rk4.solve(f); });
+
+   cout << "RK4 lorentz , tf = " << tf << " , dt = " << dt << endl ;
+   cout << setw(24) << left << "std::endl per step" << tEndl  << " s" << endl ;
+   cout << setw(24) << left << "buffered text"      << tText  << " s" << endl ;
+   cout << setw(24) << left << "binary"             << tBin   << " s" << endl ;
+   cout << setw(24) << left << "async text"         << tAsync << " s" << endl ;
+   cout << setw(24) << left << "text every 10 steps"<< tDec   << " s" << endl ;
+   cout << setw(24) << left << "null (solver only)" << tNull  << " s" << endl ;
+
+  return 0;
+}
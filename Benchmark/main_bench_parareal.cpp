@@ -0,0 +1,121 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <vector>
+# include <thread>
+# include <algorithm>
+# include "../rhsODEproblem.H"
+# include "../Output/ObserverSink.H"
+# include "../Euler/ForwardEulerSolver.H"
+# include "../RungeKutta/Heun/HeunSolver.H"
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../Parareal/PararealSolver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : Parareal on a long horizon
+ *
+ *      Van der Pol (mu = 1) on [0 , 1000] , RK4 fine dt = 1e-4
+ *      (10^7 steps) , forward Euler or Heun coarse ; 32 , 64 and
+ *      128 windows on a pool of all the cores
+ *
+ *      iterations , last correction , serial RK4 and Parareal time ,
+ *      speedup measured here and predicted for 32 / 64 cores (from
+ *      the measured coarse and window times) , error against the
+ *      serial RK4 run at tf
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto vanDerPol = [](const double , const double* y , double* dydt)
+                 {
+                    dydt[0] = y[1] ;
+                    dydt[1] = (1 - y[0]*y[0]) * y[1] - y[0] ;
+                 };
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+template <typename Solver>
+std::vector<double> finalState(Solver& s)
+{
+   std::vector<double> last ;
+   ObserverSink<double> out([&last](const double , const double* u , const std::size_t n){ last.assign(u , u + n) ; }) ;
+   s.solve(out) ;
+   return last ;
+}
+
+
+template <typename Coarse>
+void run(const string& name , const rhsODEProblem<double>& p , const std::size_t windows , const double H ,
+         const std::vector<double>& exact , const double serial)
+{
+   PararealSolver<double , Coarse , RungeKutta4Solver<double>> pr(p , windows , H , std::max(1u , std::thread::hardware_concurrency())) ;
+   pr.setTolerances(1.0e-8 , 1.0e-8) ;
+
+   std::streambuf* console = cout.rdbuf(nullptr) ;
+   std::vector<double> last ;
+   const double time = timeIt([&](){ last = finalState(pr) ; }) ;
+   cout.rdbuf(console) ;
+
+   double error = 0 ;
+   for(std::size_t i=0 ; i < exact.size() ; i++)
+      error = std::max(error , std::abs(last[i] - exact[i])) ;
+
+   const auto& info = pr.pararealStatistics() ;
+   cout << setw(10) << left << name << right << setw(8) << windows << setw(8) << H
+        << setw(6) << info.iterations << (info.converged ? " " : "*")
+        << setw(12) << (info.corrections.empty() ? 0.0 : info.corrections.back())
+        << setw(10) << serial << setw(10) << time << setw(10) << serial / time
+        << setw(9) << info.predictedSpeedup(32) << setw(9) << info.predictedSpeedup(64)
+        << setw(12) << error << endl ;
+}
+
+
+int main(){
+
+   cout << setprecision(3) ;
+   const double tf = 1000.0 , dt = 1.0e-4 ;
+   const rhsODEProblem<double> p(vanDerPol , 0.0 , tf , dt , {2.0 , 0.0}) ;
+   const rhsODEProblem<double> q(vanDerPol , 0.0 , tf + dt/2 , dt , {2.0 , 0.0}) ;   // record at tf
+
+   std::vector<double> exact ;
+   std::streambuf* console = cout.rdbuf(nullptr) ;
+   RungeKutta4Solver<double> rk4(q) ;
+   const double serial = timeIt([&](){ exact = finalState(rk4) ; }) ;
+   cout.rdbuf(console) ;
+
+   cout << "workers " << std::max(1u , std::thread::hardware_concurrency()) << " , serial RK4 "
+        << std::size_t(tf/dt) << " steps " << serial << " s" << endl << endl ;
+
+   cout << setw(10) << left << "coarse" << right << setw(8) << "windows" << setw(8) << "H"
+        << setw(7) << "iter" << setw(12) << "correction" << setw(10) << "serial s" << setw(10) << "para s"
+        << setw(10) << "speedup" << setw(9) << "32 cores" << setw(9) << "64 cores" << setw(12) << "error" << endl ;
+
+   for(const std::size_t windows : {32 , 64 , 128})
+   {
+      run<ForwardEulerSolver<double>>("Euler" , p , windows , 1.0e-2 , exact , serial) ;
+      run<HeunSolver<double>>        ("Heun"  , p , windows , 1.0e-1 , exact , serial) ;
+      run<HeunSolver<double>>        ("Heun"  , p , windows , 2.5e-2 , exact , serial) ;
+   }
+   cout << endl << "* not converged" << endl ;
+
+   return 0 ;
+}
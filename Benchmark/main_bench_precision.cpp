@@ -0,0 +1,187 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <vector>
+# include <type_traits>
+# include "../rhsODEproblem.H"
+# include "../Output/ObserverSink.H"
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../RungeKutta/ExplicitRungeKutta/MixedPrecisionRungeKuttaSolver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : precision of the RK4 time loop , throughput
+ *      against accuracy
+ *
+ *      y_i' = -a_i y_i , a_i in [0.05 , 0.15] (exact solution
+ *      exp(-a_i t))
+ *
+ *      --> throughput : n = 10^5 , 1000 steps ; float , double ,
+ *                       long double , float stages / double state ,
+ *                       double stages / long double state , double
+ *                       compensated (component steps per second ,
+ *                       against double)
+ *      --> long run   : n = 16 , 10^7 steps of 1e-6 ; what the
+ *                       rounding leaves of the solution , plain and
+ *                       compensated
+ *
+ *      max error against the exact solution at the last record
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+//-- rates a_i in every precision , the rhs for any of them
+struct Rates
+{
+   std::vector<float>       f ;
+   std::vector<double>      d ;
+   std::vector<long double> l ;
+
+   explicit Rates(const std::size_t n)
+   {
+      for(std::size_t i=0 ; i < n ; i++)
+      {
+         const long double a = 0.05L + 0.1L * i / n ;
+         f.push_back(float(a)) ; d.push_back(double(a)) ; l.push_back(a) ;
+      }
+   }
+
+   template <typename Type>
+   const Type* get() const noexcept
+   {
+      if constexpr( std::is_same<Type , float>::value )       return f.data() ;
+      else if constexpr( std::is_same<Type , double>::value ) return d.data() ;
+      else                                                     return l.data() ;
+   }
+};
+
+
+auto rhsOf(const Rates& r , const std::size_t n)
+{
+   return [&r , n](const auto , const auto* y , auto* dydt)
+          {
+             using Type = std::remove_const_t<std::remove_pointer_t<decltype(y)>> ;
+             const Type* a = r.get<Type>() ;
+             for(std::size_t i=0 ; i < n ; i++)
+                dydt[i] = -a[i] * y[i] ;
+          };
+}
+
+
+template <typename Type>
+rhsODEProblem<Type> problem(const Rates& r , const std::size_t n , const long double tf , const long double dt)
+{
+   return rhsODEProblem<Type>(rhsOf(r , n) , Type(0) , Type(tf + dt/2) , Type(dt) ,            // record at tf
+                              std::valarray<Type>(Type(1) , n)) ;
+}
+
+
+struct Result { double time = 0 ; long double error = 0 ; long double t = 0 ; } ;
+
+template <typename Solver>
+Result run(Solver& s , const Rates& r)
+{
+   Result res ;
+   std::vector<long double> y ;
+   std::streambuf* console = cout.rdbuf(nullptr) ;
+   res.time = timeIt([&]()
+   {
+      s.observe([&](const auto t , const auto* u , const std::size_t n){ res.t = t ; y.assign(u , u + n) ; }) ;
+   }) ;
+   cout.rdbuf(console) ;
+
+   for(std::size_t i=0 ; i < y.size() ; i++)
+      res.error = std::max(res.error , std::abs(y[i] - std::exp(-r.l[i] * res.t))) ;
+   return res ;
+}
+
+
+void report(const string& what , const Result& r , const std::size_t work , const double reference)
+{
+   cout << setw(28) << left << what << right << setw(10) << r.time << setw(12) << work / r.time / 1.0e6
+        << setw(10) << reference / r.time << setw(14) << double(r.error) << endl ;
+}
+
+
+int main(){
+
+   cout << setprecision(3) ;
+
+   //-- throughput
+   {
+      const std::size_t n = 100000 ;
+      const Rates r(n) ;
+      const auto  f = rhsOf(r , n) ;
+      const std::size_t work = n * 1000 ;
+
+      cout << "n = " << n << " , 1000 steps" << endl ;
+      cout << setw(28) << left << "RK4" << right << setw(10) << "time s" << setw(12) << "M comp/s"
+           << setw(10) << "x double" << setw(14) << "error" << endl ;
+
+      RungeKutta4Solver<double> d(problem<double>(r , n , 1.0 , 1.0e-3)) ;
+      const Result rd = run(d , r) ;
+
+      RungeKutta4Solver<float>       f32(problem<float>(r , n , 1.0 , 1.0e-3)) ;
+      RungeKutta4Solver<long double> f80(problem<long double>(r , n , 1.0 , 1.0e-3)) ;
+      RungeKutta4Solver<double>      dc (problem<double>(r , n , 1.0 , 1.0e-3)) ;
+      dc.setCompensatedSummation(true) ;
+      MixedPrecisionRungeKuttaSolver<double , float , RungeKutta4Tableau>       m1(problem<double>(r , n , 1.0 , 1.0e-3) , f) ;
+      MixedPrecisionRungeKuttaSolver<long double , double , RungeKutta4Tableau> m2(problem<long double>(r , n , 1.0 , 1.0e-3) , f) ;
+
+      report("float"                  , run(f32 , r) , work , rd.time) ;
+      report("double"                 , rd           , work , rd.time) ;
+      report("long double"            , run(f80 , r) , work , rd.time) ;
+      report("float / double"         , run(m1  , r) , work , rd.time) ;
+      report("double / long double"   , run(m2  , r) , work , rd.time) ;
+      report("double compensated"     , run(dc  , r) , work , rd.time) ;
+      cout << endl ;
+   }
+
+   //-- long run
+   {
+      const std::size_t n = 16 ;
+      const Rates r(n) ;
+      const auto  f = rhsOf(r , n) ;
+      const std::size_t work = n * 10000000 ;
+
+      cout << "n = " << n << " , 10^7 steps" << endl ;
+      cout << setw(28) << left << "RK4" << right << setw(10) << "time s" << setw(12) << "M comp/s"
+           << setw(10) << "x double" << setw(14) << "error" << endl ;
+
+      RungeKutta4Solver<double> d(problem<double>(r , n , 10.0 , 1.0e-6)) ;
+      const Result rd = run(d , r) ;
+
+      RungeKutta4Solver<float>  f32(problem<float>(r , n , 10.0 , 1.0e-6)) , f32c(problem<float>(r , n , 10.0 , 1.0e-6)) ;
+      RungeKutta4Solver<double> dc(problem<double>(r , n , 10.0 , 1.0e-6)) ;
+      f32c.setCompensatedSummation(true) ;
+      dc.setCompensatedSummation(true) ;
+      MixedPrecisionRungeKuttaSolver<double , float , RungeKutta4Tableau> m1(problem<double>(r , n , 10.0 , 1.0e-6) , f) ;
+
+      report("float"                  , run(f32  , r) , work , rd.time) ;
+      report("float compensated"      , run(f32c , r) , work , rd.time) ;
+      report("float / double"         , run(m1   , r) , work , rd.time) ;
+      report("double"                 , rd            , work , rd.time) ;
+      report("double compensated"     , run(dc   , r) , work , rd.time) ;
+   }
+
+   return 0 ;
+}
@@ -0,0 +1,99 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../rhsODEproblem.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : per-component rhs (std::function vector , adapter)
+ *                  vs whole system rhs  f(t, u, dudt)
+ *      on the lorentz attractor problem (main_test_lorentzAttractor)
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto numFun1 =[](const double t , std::valarray<double> y){return  10.0 * (y[1] - y[0]) ; } ;
+auto numFun2 =[](const double t , std::valarray<double> y){return  28.0 * y[0] - y[1] - y[0] * y[2] ; } ;
+auto numFun3 =[](const double t , std::valarray<double> y){return -8.0/3.0 * y[2] + y[0]* y[1] ; } ;
+
+auto lorentz =[](const double t , const double* y , double* dydt)
+              {
+                 dydt[0] =  10.0 * (y[1] - y[0]) ;
+                 dydt[1] =  28.0 * y[0] - y[1] - y[0] * y[2] ;
+                 dydt[2] = -8.0/3.0 * y[2] + y[0]* y[1] ;
+              };
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+int main(){
+
+   std::vector<std::function<const double (const double, const std::valarray<double>)>>  function ;
+
+   function.push_back(numFun1);
+   function.push_back(numFun2);
+   function.push_back(numFun3);
+
+   const double t0 = 0.0;
+   const double tf = 100.0 ;
+   const double dt = 0.01;
+   const std::valarray<double> u0 = {1.0,0.0,0.0} ;
+
+   const std::size_t Neval = 10000000 ;
+
+   rhsODEProblem<double> legacy(function, t0, tf , dt, u0 );
+   rhsODEProblem<double> system(lorentz , t0, tf , dt, u0 );
+
+
+   std::valarray<double> u = u0 , dudt(u0.size()) ;
+   double check = 0.0 ;
+
+   const double tLegacy = timeIt([&](){
+                                   for(std::size_t i=0 ; i < Neval ; i++){
+                                       legacy.eval(0.0 , &u[0] , &dudt[0]) ;
+                                       check += dudt[1] ;
+                                   }
+                                });
+   const double tSystem = timeIt([&](){
+                                   for(std::size_t i=0 ; i < Neval ; i++){
+                                       system.eval(0.0 , &u[0] , &dudt[0]) ;
+                                       check += dudt[1] ;
+                                   }
+                                });
+
+   cout << "rhs evaluations : " << Neval << "  (check " << check << ")" << endl ;
+   cout << setw(24) << left << "per-component (adapter)" << tLegacy << " s" << endl ;
+   cout << setw(24) << left << "whole system"            << tSystem << " s"
+        << "   speed-up x" << tLegacy/tSystem << endl ;
+
+
+   RungeKutta4Solver<double> rk4Legacy(legacy);
+   RungeKutta4Solver<double> rk4System(system);
+
+   const double sLegacy = timeIt([&](){ rk4Legacy.solve("RK4Legacy_lorentz.out"); });
+   const double sSystem = timeIt([&](){ rk4System.solve("RK4System_lorentz.out"); });
+
+   cout << "RK4 solve (tf = " << tf << " , dt = " << dt << ")" << endl ;
+   cout << setw(24) << left << "per-component (adapter)" << sLegacy << " s" << endl ;
+   cout << setw(24) << left << "whole system"            << sSystem << " s" << endl ;
+
+  return 0;
+}
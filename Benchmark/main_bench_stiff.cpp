@@ -0,0 +1,87 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include <algorithm>
+# include "StiffProblems.H"
+# include "../MultiStep/BDF/BDFSolver.H"
+# include "../RungeKutta/TRBDF2/TRBDF2Solver.H"
+# include "../RungeKutta/SDIRK/SDIRK4Solver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : stiff solvers (variable order BDF , TR-BDF2 ,
+ *                  SDIRK4) on the stiff set (StiffProblems.H)
+ *      at several tolerances , analytic and finite difference
+ *      Jacobian
+ *
+ *      steps , rejected steps , Jacobians , LU , Newton iterations ,
+ *      time and max relative error at tf (floor 1e-6 on the scale)
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+template <typename Function>
+double timeIt(Function&& fun)
+{
+   const auto start = std::chrono::steady_clock::now();
+   fun();
+   const auto stop  = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(stop - start).count();
+}
+
+
+template <typename Solver>
+void run(const string& name , const StiffProblem& p , const double tol)
+{
+   Solver s(p.problem) ;
+   s.setTolerances(tol , tol) ;
+
+   std::valarray<double> last(p.reference.size()) ;
+   const double time = timeIt([&](){
+                                s.observe([&](const double t , const double* u , const std::size_t n)
+                                          { for(std::size_t i=0 ; i < n ; i++) last[i] = u[i] ; });
+                             });
+
+   double err = 0.0 ;
+   for(std::size_t i=0 ; i < last.size() ; i++)
+      err = std::max(err , std::abs(last[i] - p.reference[i]) / std::max(1.0e-6 , std::abs(p.reference[i]))) ;
+
+   const auto& newton = s.nonlinearSolver() ;
+   cout << setw(20) << p.name << setw(10) << name << setw(8) << tol
+        << setw(9) << s.accepted() << setw(6) << s.rejected()
+        << setw(6) << newton.jacobians << setw(8) << newton.factorizations << setw(9) << newton.iterations
+        << setw(11) << setprecision(3) << err << setw(10) << time << setprecision(6) << endl ;
+}
+
+
+int main(){
+
+   cout << setw(20) << "problem" << setw(10) << "solver" << setw(8) << "tol"
+        << setw(9) << "steps" << setw(6) << "rej"
+        << setw(6) << "jac" << setw(8) << "LU" << setw(9) << "newton"
+        << setw(11) << "error" << setw(10) << "time[s]" << endl ;
+
+   for(const bool analytic : { true , false })
+   {
+      cout << ( analytic ? "-- analytic Jacobian" : "-- finite difference Jacobian" ) << endl ;
+
+      for(const auto& p : { robertson(analytic) , vanDerPol(analytic) , hires(analytic) })
+         for(const double tol : { 1.0e-4 , 1.0e-6 , 1.0e-8 })
+         {
+            run<BDFSolver<double>   >("BDF"    , p , tol) ;
+            run<TRBDF2Solver<double>>("TR-BDF2", p , tol) ;
+            run<SDIRK4Solver<double>>("SDIRK4" , p , tol) ;
+         }
+   }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <cmath>
+# include "../Output/ObserverSink.H"
+# include "../Symplectic/PartitionedProblem.H"
+# include "../Symplectic/StormerVerletSolver.H"
+# include "../Symplectic/YoshidaSolver.H"
+# include "../Symplectic/ForestRuthSolver.H"
+# include "../Symplectic/EnergyDriftSink.H"
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : long run energy error , Kepler problem e = 0.5
+ *
+ *      horizon of 10^7 RK4 steps (200 steps per period , 50000
+ *      periods) ; the symplectic solvers on the same horizon with
+ *      steps 1 .. 50 times larger
+ *
+ *      force evaluations , time , max relative energy error , drift
+ *      (de/dt) and position error at tf (a whole number of periods :
+ *      exact solution = q0) ; "<= RK4" marks the runs at least as
+ *      accurate in energy as RK4
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+const double pi      = 3.14159265358979323846 ;
+const double e       = 0.5 ;
+const int    periods = 50000 ;
+const int    base    = 200 ;                  // RK4 steps per period
+
+
+PartitionedProblem<double> kepler(const int stepsPerPeriod)
+{
+   PartitionedProblem<double> p([](const double t , const double* q , double* f)
+                                {
+                                   const double r  = std::sqrt(q[0]*q[0] + q[1]*q[1]) ;
+                                   const double r3 = r*r*r ;
+                                   f[0] = -q[0]/r3 ;
+                                   f[1] = -q[1]/r3 ;
+                                } ,
+                                0.0 , periods*2*pi , 2*pi/stepsPerPeriod ,
+                                {1.0 - e , 0.0} , {0.0 , std::sqrt((1.0 + e)/(1.0 - e))}) ;
+
+   p.setEnergy([](const double* q , const double* p)
+               { return 0.5*(p[0]*p[0] + p[1]*p[1]) - 1.0/std::sqrt(q[0]*q[0] + q[1]*q[1]) ; }) ;
+   return p ;
+}
+
+
+template <typename Solver>
+double run(const string& name , const int stepsPerPeriod , const double reference)
+{
+   const auto p = kepler(stepsPerPeriod) ;
+   Solver     s(p) ;
+
+   double x = 0 , y = 0 ;
+   ObserverSink<double>    last([&](const double t , const double* u , const std::size_t n){ x = u[0] ; y = u[1] ; }) ;
+   EnergyDriftSink<double> out(p , last) ;
+
+   const auto start = std::chrono::steady_clock::now();
+   s.solve(out) ;
+   const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   const double err = out.maxError() ;
+   cout << setw(16) << name << setw(8) << base/stepsPerPeriod << setw(12) << out.records() - 1
+        << setw(12) << s.statistics().rhsEvaluations << setw(10) << setprecision(3) << time
+        << setw(12) << err << setw(12) << out.drift() << setw(12) << std::hypot(x - (1.0 - e) , y)
+        << ( reference > 0 && err <= reference ? "   <= RK4" : "" ) << setprecision(6) << endl ;
+   return err ;
+}
+
+
+int main(){
+
+   cout << setw(16) << "solver" << setw(8) << "dt x" << setw(12) << "steps"
+        << setw(12) << "forces" << setw(10) << "time[s]"
+        << setw(12) << "max dE/E" << setw(12) << "drift" << setw(12) << "|q-q0|" << endl ;
+
+   const double reference = run<RungeKutta4Solver<double>>("RungeKutta4" , base , 0.0) ;
+
+   for(const int m : { 200 , 100 , 40 , 20 , 10 , 4 })            // dt x 1 , 2 , 5 , 10 , 20 , 50
+   {
+      run<StormerVerletSolver<double>>("StormerVerlet" , m , reference) ;
+      run<Yoshida4Solver<double>>     ("Yoshida4"      , m , reference) ;
+      run<PEFRLSolver<double>>        ("PEFRL"         , m , reference) ;
+      run<Yoshida6Solver<double>>     ("Yoshida6"      , m , reference) ;
+   }
+
+   return 0 ;
+}
@@ -0,0 +1,352 @@
+# include <iostream>
+# include <iomanip>
+# include <fstream>
+# include <sstream>
+# include <string>
+# include <map>
+# include <chrono>
+# include <cmath>
+# include <algorithm>
+# include <limits>
+# include <utility>
+# include "NonStiffProblems.H"
+# include "../Output/OutputSink.H"
+# include "../Euler/ForwardEulerSolver.H"
+# include "../Euler/BackwardEulerSolver.H"
+# include "../RungeKutta/Heun/HeunSolver.H"
+# include "../RungeKutta/ModifiedEuler/ModifiedEulerSolver.H"
+# include "../RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "../RungeKutta/RungeKuttaMerson/RungeKuttaMerson5thSolver.H"
+# include "../RungeKutta/RungeKuttaFehlberg/RungeKuttaFehlberg45Solver.H"
+# include "../RungeKutta/RungeKuttaFehlberg/RungeKuttaFehlberg5thSolver.H"
+# include "../RungeKutta/DormandPrince/DormandPrince5Solver.H"
+# include "../RungeKutta/Tsitouras/Tsitouras5Solver.H"
+# include "../RungeKutta/Verner/Verner6Solver.H"
+# include "../RungeKutta/CrankNicholson/CrankNicholsonSolver.H"
+# include "../RungeKutta/TRBDF2/TRBDF2Solver.H"
+# include "../RungeKutta/SDIRK/SDIRK4Solver.H"
+# include "../MultiStep/LeapFrogSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth2ndSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth3thSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth4thSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth5thSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton2ndSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton3thSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton4thSolver.H"
+# include "../MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton5thSolver.H"
+# include "../MultiStep/AdamsMethods/AdaptiveAdamsSolver.H"
+# include "../MultiStep/BDF/BDFSolver.H"
+
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Benchmark : work-precision of every solver on the non stiff
+ *                  set (NonStiffProblems.H)
+ *
+ *      fixed step solvers : dt , dt/2 , ... dt/32
+ *      adaptive solvers   : atol = rtol = 1e-3 ... 1e-10
+ *
+ *      per run : wall time (min over repetitions , records to a
+ *      NullSink) , rhs evaluations , steps , rejected steps and the
+ *      global error (max over the records , against the analytic
+ *      solution , inf if the solver throws)
+ *
+ *      usage :  main_bench_workprecision [out.csv] [--baseline old.csv [--time-factor f]]
+ *
+ *      the csv (default workprecision.csv) has one line per run ,
+ *      with --baseline every run is compared to the same run of
+ *      old.csv : more rhs evaluations , error grown by more than 10 %
+ *      or time grown by more than f (default 1.5 , runs above 1 ms)
+ *      are reported as regressions and the exit code is 1
+ *      (counters and errors are exact , times are as good as the
+ *      machine is quiet)
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+struct Run
+{
+   double       time ;
+   std::size_t  evaluations ;
+   std::size_t  steps ;
+   std::size_t  rejected ;
+   double       error ;
+};
+
+
+//-- records compared with the analytic solution
+class ErrorSink
+                 : public OutputSink<double>
+{
+   public:
+
+      explicit ErrorSink(const TestProblem& p) : problem{p} {}
+
+      void write(const double t , const double* u) override
+      {
+         err = std::max(err , problem.error(t , u)) ;
+         count++ ;
+      }
+
+      double      error()   const noexcept { return err ; }
+      std::size_t records() const noexcept { return count ; }
+
+   private:
+
+      const TestProblem& problem ;
+      double      err   = 0.0 ;
+      std::size_t count = 0 ;
+};
+
+
+//-- step counters of the adaptive solvers , records - 1 for the others
+template <typename Solver>
+auto steps(const Solver& s , const std::size_t , int) -> decltype(s.accepted() , std::pair<std::size_t , std::size_t>())
+{
+   return { s.accepted() , s.rejected() } ;
+}
+
+template <typename Solver>
+std::pair<std::size_t , std::size_t> steps(const Solver& , const std::size_t records , long)
+{
+   return { records > 0 ? records - 1 : 0 , 0 } ;
+}
+
+
+//-- the solvers talk on std::cout ("Running ... Done") , muted while measuring
+struct Quiet
+{
+   std::streambuf* table = cout.rdbuf(nullptr) ;
+   ~Quiet() { cout.rdbuf(table) ; }                // rdbuf() clears the bad bit
+};
+
+
+template <typename Solver>
+Run measure(Solver& s , const TestProblem& p)
+{
+   const Quiet quiet ;
+   Run r ;
+
+   //-- accuracy and counters , a failed run (Newton , step size underflow ...)
+   //   has an infinite error and is not timed
+   ErrorSink check(p) ;
+   *p.evaluations = 0 ;
+   bool failed = false ;
+   try
+   {
+      s.solve(check) ;
+   }
+   catch(const std::exception& e)
+   {
+      failed = true ;
+   }
+   r.evaluations = *p.evaluations ;
+   r.error       = failed ? std::numeric_limits<double>::infinity() : check.error() ;
+   std::tie(r.steps , r.rejected) = steps(s , check.records() , 0) ;
+   r.time = 0.0 ;
+   if( failed )
+      return r ;
+
+   //-- timing : at least 3 runs and 20 ms , at most 100 runs
+   NullSink<double> out ;
+   r.time = std::numeric_limits<double>::max() ;
+   double total = 0.0 ;
+   for(int rep=0 ; rep < 100 && ( rep < 3 || total < 0.02 ) ; rep++)
+   {
+      const auto start = std::chrono::steady_clock::now();
+      s.solve(out) ;
+      const auto stop  = std::chrono::steady_clock::now();
+      const double dt  = std::chrono::duration<double>(stop - start).count();
+      r.time = std::min(r.time , dt) ;
+      total += dt ;
+   }
+   return r ;
+}
+
+
+class Report
+{
+   public:
+
+      Report(const string& csvName , const string& baselineName , const double factor) :
+                                                         csv{csvName} , timeFactor{factor}
+      {
+         if( !csv )
+            throw std::runtime_error(">> cannot open " + csvName + " <<");
+         csv << "problem,solver,control,value,time_s,rhs_evals,steps,rejected,max_error\n" ;
+         csv << std::setprecision(6) ;
+
+         if( !baselineName.empty() )
+            readBaseline(baselineName) ;
+
+         cout << setw(18) << "problem" << setw(20) << "solver" << setw(5) << "" << setw(10) << "dt/tol"
+              << setw(11) << "time[s]" << setw(10) << "rhs" << setw(9) << "steps" << setw(6) << "rej"
+              << setw(11) << "error" << endl ;
+      }
+
+      void add(const TestProblem& p , const string& solver , const string& control , const double value , const Run& r)
+      {
+         ostringstream key ;
+         key << p.name << ',' << solver << ',' << control << ',' << std::setprecision(6) << value ;
+
+         csv << key.str() << ',' << r.time << ',' << r.evaluations << ',' << r.steps << ','
+             << r.rejected << ',' << r.error << '\n' ;
+
+         cout << setw(18) << p.name << setw(20) << solver << setw(5) << control << setw(10) << setprecision(3) << value
+              << setw(11) << r.time << setw(10) << r.evaluations << setw(9) << r.steps << setw(6) << r.rejected
+              << setw(11) << r.error << setprecision(6) ;
+
+         const auto old = baseline.find(key.str()) ;
+         if( old != baseline.end() )
+         {
+            const Run& b = old->second ;
+            string why ;
+            if( r.evaluations > b.evaluations )                         why += " rhs" ;
+            if( r.error > 1.1 * b.error + 1.0e-14 )                     why += " error" ;
+            if( r.time > timeFactor * b.time && r.time > 1.0e-3 )        why += " time" ;
+            if( !why.empty() )
+            {
+               cout << "   REGRESSION" << why ;
+               regressions++ ;
+            }
+         }
+         cout << endl ;
+      }
+
+      int regressionCount() const noexcept { return regressions ; }
+      bool hasBaseline() const noexcept { return !baseline.empty() ; }
+
+   private:
+
+      ofstream csv ;
+      double   timeFactor ;
+      std::map<string , Run> baseline ;
+      int regressions = 0 ;
+
+      void readBaseline(const string& name)
+      {
+         ifstream in(name) ;
+         if( !in )
+            throw std::runtime_error(">> cannot open baseline " + name + " <<");
+
+         string line ;
+         getline(in , line) ;                           // header
+         while( getline(in , line) )
+         {
+            //-- the first 4 fields are the key
+            std::size_t pos = 0 ;
+            for(int f=0 ; f < 4 && pos != string::npos ; f++)
+               pos = line.find(',' , pos + (f > 0)) ;
+            if( pos == string::npos )
+               continue ;
+
+            Run r ;
+            char sep ;
+            istringstream values(line.substr(pos + 1)) ;
+            values >> r.time >> sep >> r.evaluations >> sep >> r.steps >> sep >> r.rejected >> sep >> r.error ;
+            if( values )
+               baseline[line.substr(0 , pos)] = r ;
+         }
+      }
+};
+
+
+template <typename Solver>
+void fixedStep(Report& report , const string& name , const TestProblem& p)
+{
+   for(int k=0 ; k <= 5 ; k++)
+   {
+      const double dt = p.problem.dt() / (1 << k) ;
+      rhsODEProblem<double> q(p.problem) ;          // shares the rhs (and its counter)
+      q.setStepSize(dt) ;
+
+      Solver s(q) ;
+      report.add(p , name , "dt" , dt , measure(s , p)) ;
+   }
+}
+
+
+template <typename Solver>
+void tolerance(Report& report , const string& name , const TestProblem& p)
+{
+   for(const double tol : { 1.0e-3 , 1.0e-4 , 1.0e-5 , 1.0e-6 , 1.0e-7 , 1.0e-8 , 1.0e-9 , 1.0e-10 })
+   {
+      Solver s(p.problem) ;
+      s.setTolerances(tol , tol) ;
+      report.add(p , name , "tol" , tol , measure(s , p)) ;
+   }
+}
+
+
+int main(int argc , char* argv[]){
+
+   string csvName = "workprecision.csv" , baselineName ;
+   double timeFactor = 1.5 ;
+   for(int i=1 ; i < argc ; i++)
+   {
+      const string arg = argv[i] ;
+      if( arg == "--baseline" && i+1 < argc )
+         baselineName = argv[++i] ;
+      else if( arg == "--time-factor" && i+1 < argc )
+         timeFactor = std::stod(argv[++i]) ;
+      else
+         csvName = arg ;
+   }
+
+   try
+   {
+      Report report(csvName , baselineName , timeFactor) ;
+
+      for(const auto& p : nonStiffSet())
+      {
+         fixedStep<ForwardEulerSolver<double>>         (report , "ForwardEuler"     , p) ;
+         fixedStep<BackwardEulerSolver<double>>        (report , "BackwardEuler"    , p) ;
+         fixedStep<HeunSolver<double>>                 (report , "Heun"             , p) ;
+         fixedStep<ModifiedEulerSolver<double>>        (report , "ModifiedEuler"    , p) ;
+         fixedStep<RungeKutta4Solver<double>>          (report , "RungeKutta4"      , p) ;
+         fixedStep<RungeKuttaMerson5thSolver<double>>  (report , "Merson"           , p) ;
+         fixedStep<RKFehlberg54thSolver<double>>       (report , "Fehlberg5"        , p) ;
+         fixedStep<DormandPrince5Solver<double>>       (report , "DormandPrince5"   , p) ;
+         fixedStep<Tsitouras5Solver<double>>           (report , "Tsitouras5"       , p) ;
+         fixedStep<Verner6Solver<double>>              (report , "Verner6"          , p) ;
+         fixedStep<CrankNicholsonSolver<double>>       (report , "CrankNicolson"    , p) ;
+         fixedStep<LeapFrogSolver<double>>             (report , "LeapFrog"         , p) ;
+         fixedStep<AdamsBashforth2ndSolver<double>>    (report , "AdamsBashforth2"  , p) ;
+         fixedStep<AdamsBashforth3thSolver<double>>    (report , "AdamsBashforth3"  , p) ;
+         fixedStep<AdamsBashforth4thSolver<double>>    (report , "AdamsBashforth4"  , p) ;
+         fixedStep<AdamsBashforth5thSolver<double>>    (report , "AdamsBashforth5"  , p) ;
+         fixedStep<AdamsMoulton2ndSolver<double>>      (report , "AdamsMoulton2"    , p) ;
+         fixedStep<AdamsMoulton3thSolver<double>>      (report , "AdamsMoulton3"    , p) ;
+         fixedStep<AdamsMoulton4thSolver<double>>      (report , "AdamsMoulton4"    , p) ;
+         fixedStep<AdamsMoulton5thSolver<double>>      (report , "AdamsMoulton5"    , p) ;
+
+         tolerance<AdaptiveRungeKuttaMersonSolver<double>>                        (report , "Merson(adapt)"    , p) ;
+         tolerance<RungeKuttaFehlberg45Solver<double>>                            (report , "Fehlberg45"       , p) ;
+         tolerance<AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau>>      (report , "DormandPrince5"   , p) ;
+         tolerance<AdaptiveAdamsSolver<double>>                                   (report , "AdaptiveAdams"    , p) ;
+         tolerance<TRBDF2Solver<double>>                                          (report , "TR-BDF2"          , p) ;
+         tolerance<SDIRK4Solver<double>>                                          (report , "SDIRK4"           , p) ;
+         tolerance<BDFSolver<double>>                                             (report , "BDF"              , p) ;
+      }
+
+      cout << "work-precision data written to " << csvName << endl ;
+      if( report.hasBaseline() )
+      {
+         cout << report.regressionCount() << " regressions against " << baselineName << endl ;
+         return report.regressionCount() == 0 ? 0 : 1 ;
+      }
+   }
+   catch(const std::exception& e)
+   {
+      std::cerr << e.what() << std::endl ;
+      return 2 ;
+   }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "MultiStep/RingHistory.H"
+# include "MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforthSolver.H"
+# include "MultiStep/AdamsMethods/AdamsMoulton/AdamsMoultonSolver.H"
+# include "MultiStep/AdamsMethods/AdaptiveAdamsSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : Adams methods (AdamsMethods , RingHistory ,
+ *             AdaptiveAdamsSolver)
+ *
+ *      harmonic oscillator y'' = -y , y(0) = 1 , y'(0) = 0 (cos t)
+ *
+ *      - RingHistory : more pushes than slots , newest first , the
+ *        slots are reused in place
+ *      - empirical order of Adams-Bashforth and Adams-Moulton , K = 2..5
+ *        (error at t = 4 with h and h/2 , start up included)
+ *      - variable step , variable order Adams : error against the
+ *        tolerance , order raised , dense output at requested times
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+rhsODEProblem<double> oscillator(const double tf , const double dt)
+{
+   return rhsODEProblem<double>([](const double , const double* y , double* dydt){ dydt[0] = y[1] ; dydt[1] = -y[0] ; } ,
+                                0.0 , tf , dt , {1.0 , 0.0}) ;
+}
+
+
+//-- max error on the records at t = tf (cos , -sin)
+template <typename Solver>
+double finalError(Solver& s , const double tf)
+{
+   double error = -1 ;
+   s.setQuiet(true) ;
+   s.observe([&](const double t , const double* y , const std::size_t)
+             {
+                if( std::abs(t - tf) < 1.0e-9 )
+                   error = std::max(std::abs(y[0] - std::cos(t)) , std::abs(y[1] + std::sin(t))) ;
+             }) ;
+   return error ;
+}
+
+
+//-- log2 of the error ratio of h and h/2
+template <template <typename , std::size_t> class Solver , std::size_t K>
+double order(const double h)
+{
+   const double tf = 4.0 ;
+   Solver<double , K> coarse(oscillator(tf + h/4 , h)) , fine(oscillator(tf + h/4 , h/2)) ;
+   const double ec = finalError(coarse , tf) , ef = finalError(fine , tf) ;
+   return ec > 0 && ef > 0 ? std::log2(ec / ef) : 0 ;
+}
+
+
+template <template <typename , std::size_t> class Solver , std::size_t... K>
+void orders(const string& name , const double h , std::index_sequence<K...>)
+{
+   (( [&]()
+      {
+         const double p = order<Solver , K>(h) ;
+         cout << name << " K = " << K << " : order " << p << endl ;
+         check(name + " K = " + std::to_string(K) + " : order K" , std::abs(p - K) < 0.3) ;
+      }() ) , ...) ;
+}
+
+
+int main(){
+
+   //-- ring history
+   {
+      RingHistory<double , 3> ring ;
+      for(auto& b : ring.buffers())
+         b.resize(2) ;
+      const double* slots[3] = { &ring.buffers()[0][0] , &ring.buffers()[1][0] , &ring.buffers()[2][0] } ;
+
+      bool partial = true ;
+      for(int i=0 ; i < 8 ; i++)
+      {
+         std::valarray<double>& v = ring.push() ;
+         v = double(i) ;
+         if( i < 2 ) partial = partial && ring.size() == std::size_t(i + 1) && ring[0][0] == i && ring[i][0] == 0 ;
+      }
+
+      bool inPlace = true ;
+      for(std::size_t j=0 ; j < 3 ; j++)
+         inPlace = inPlace && &ring[j][0] == slots[(j + 1) % 3] ;       // 8 pushes : head on slot 1
+
+      check("ring : size before the history is full" , partial) ;
+      check("ring : 8 pushes , 3 slots , newest first" , ring.size() == 3 && ring[0][0] == 7 && ring[1][0] == 6 && ring[2][0] == 5) ;
+      check("ring : slots reused in place" , inPlace && ring[0].size() == 2) ;
+
+      ring.clear() ;
+      ring.push() = 9.0 ;
+      check("ring : clear , then one vector" , ring.size() == 1 && ring[0][0] == 9) ;
+   }
+
+   //-- fixed step : order K
+   orders<AdamsBashforthSolver>("Adams-Bashforth" , 0.02 , std::index_sequence<2 , 3 , 4 , 5>{}) ;
+   orders<AdamsMoultonSolver>  ("Adams-Moulton"   , 0.04 , std::index_sequence<2 , 3 , 4 , 5>{}) ;
+
+   //-- variable step , variable order
+   {
+      const double tf = 10.0 ;
+      double      previous = 1 ;
+      bool        bounded = true , decreasing = true ;
+      std::size_t highest = 0 ;
+
+      for(const double tol : { 1.0e-6 , 1.0e-8 , 1.0e-10 })
+      {
+         AdaptiveAdamsSolver<double> s(oscillator(tf , 0.1)) ;
+         s.setTolerances(tol , tol) ;
+         const double error = finalError(s , tf) ;
+         cout << "adaptive Adams tol " << tol << " : error " << error << " , " << s.accepted() << " steps , order "
+              << s.order() << endl ;
+
+         bounded    = bounded    && error >= 0 && error < 100 * tol ;
+         decreasing = decreasing && error < previous ;
+         previous   = error ;
+         highest    = std::max(highest , s.order()) ;
+      }
+      check("adaptive Adams : error below 100 tol at t = 10" , bounded) ;
+      check("adaptive Adams : error decreases with tol" , decreasing) ;
+      check("adaptive Adams : order raised above 4" , highest > 4) ;
+
+      AdaptiveAdamsSolver<double> s(oscillator(tf , 0.1)) ;
+      s.setTolerances(1.0e-10 , 1.0e-10) ;
+      s.setOutputTimes({0.5 , 1.0 , 2.5 , 7.25 , 10.0}) ;
+      s.setQuiet(true) ;
+      std::vector<double> times ;
+      double dense = 0 ;
+      s.observe([&](const double t , const double* y , const std::size_t)
+                {
+                   times.push_back(t) ;
+                   dense = std::max(dense , std::abs(y[0] - std::cos(t))) ;
+                }) ;
+      check("adaptive Adams : dense output at the requested times" ,
+            times == std::vector<double>{0.5 , 1.0 , 2.5 , 7.25 , 10.0} && dense < 1.0e-8) ;
+   }
+
+   return testResult() ;
+}
@@ -0,0 +1,176 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <stdexcept>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "RungeKutta/ExplicitRungeKutta/StepSizeController.H"
+# include "RungeKutta/ExplicitRungeKutta/AdaptiveRungeKuttaSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : adaptive explicit Runge-Kutta (AdaptiveRungeKuttaSolver ,
+ *             PIStepSizeController)
+ *
+ *      - controller : factors clamped to [facMin , facMax] , no growth
+ *        right after a rejected step , growth again after that
+ *      - solver : facMax = 1.5 bounds the ratio of accepted steps
+ *      - y' = y^2 , y(0) = 1 blows up at t = 1 : "step size too small"
+ *      - harmonic oscillator , Dormand-Prince 5(4) and Fehlberg 4(5) :
+ *        error at tf below a multiple of the tolerance , decreasing
+ *        with it ; Hermite dense output at setOutputTimes against
+ *        cos t , the steps are the same with and without output times
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+rhsODEProblem<double> oscillator(const double tf)
+{
+   return rhsODEProblem<double>([](const double , const double* y , double* dydt){ dydt[0] = y[1] ; dydt[1] = -y[0] ; } ,
+                                0.0 , tf , 0.01 , {1.0 , 0.0}) ;
+}
+
+
+//-- error at tf against (cos , -sin)
+template <typename Tableau>
+double finalError(const double tf , const double tol , std::size_t& steps)
+{
+   AdaptiveRungeKuttaSolver<double , Tableau> s(oscillator(tf)) ;
+   s.setTolerances(tol , tol) ;
+   s.setQuiet(true) ;
+   const auto last = finalState(s) ;
+   steps = s.accepted() ;
+   return last.size() == 2 ? std::max(std::abs(last[0] - std::cos(tf)) , std::abs(last[1] + std::sin(tf))) : 1.0e30 ;
+}
+
+
+template <typename Tableau>
+void tolerances(const string& name , const double bound)
+{
+   const double tf = 10.0 ;
+   double previous = 1 ;
+   bool   bounded = true , decreasing = true ;
+
+   for(const double tol : { 1.0e-4 , 1.0e-6 , 1.0e-8 , 1.0e-10 })
+   {
+      std::size_t steps ;
+      const double error = finalError<Tableau>(tf , tol , steps) ;
+      cout << name << " tol " << tol << " : error " << error << " , " << steps << " steps" << endl ;
+
+      bounded    = bounded    && error < bound * tol ;
+      decreasing = decreasing && error < previous / 10 ;
+      previous   = error ;
+   }
+   check(name + " : error at tf below " + std::to_string(int(bound)) + " tol" , bounded) ;
+   check(name + " : error / 10 at least for tol / 100" , decreasing) ;
+}
+
+
+template <typename Tableau>
+void denseOutput(const string& name , const double tol , const double bound)
+{
+   const std::vector<double> times{ 0.0 , 0.123 , 1.0 , 2.5 , 4.75 , 7.0 , 9.99 , 10.0 } ;
+
+   AdaptiveRungeKuttaSolver<double , Tableau> plain(oscillator(10.0)) , dense(oscillator(10.0)) ;
+   for(auto* s : { &plain , &dense })
+   {
+      s->setTolerances(tol , tol) ;
+      s->setQuiet(true) ;
+   }
+   dense.setOutputTimes(times) ;
+
+   finalState(plain) ;
+   std::vector<double> written ;
+   double error = 0 ;
+   dense.observe([&](const double t , const double* y , const std::size_t)
+                 {
+                    written.push_back(t) ;
+                    error = std::max({error , std::abs(y[0] - std::cos(t)) , std::abs(y[1] + std::sin(t))}) ;
+                 }) ;
+   cout << name << " dense output : error " << error << " , " << dense.accepted() << " steps" << endl ;
+
+   check(name + " : dense output at the requested times , exact" , written == times && error < bound * tol) ;
+   check(name + " : steps not shrunk to hit the output times" , dense.accepted() == plain.accepted() &&
+                                                                 dense.rejected() == plain.rejected()) ;
+}
+
+
+int main(){
+
+   //-- controller
+   {
+      PIStepSizeController<double> c(5) ;
+      c.reset() ;
+      const double grow    = c.accept(1.0e-12) ;
+      const double shrink  = c.reject(1.0e12) ;
+      const double after   = c.accept(1.0e-12) ;
+      const double again   = c.accept(1.0e-12) ;
+      const double small   = c.accept(1.0) ;
+
+      check("controller : tiny error , factor clamped to facMax" , grow == c.facMax) ;
+      check("controller : huge error , factor clamped to facMin" , shrink == c.facMin) ;
+      check("controller : no growth right after a reject" , after == 1.0) ;
+      check("controller : growth again on the next step" , again == c.facMax) ;
+      check("controller : error 1 , factor below 1" , small < 1.0 && small >= c.facMin) ;
+
+      c.facMin = 0.5 ;
+      c.facMax = 2.0 ;
+      c.reset() ;
+      check("controller : facMin , facMax set by the user" , c.accept(1.0e-12) == 2.0 && c.reject(1.0e12) == 0.5) ;
+      c.reset() ;
+      check("controller : reset clears the rejected step" , c.accept(1.0e-12) == 2.0) ;
+   }
+
+   //-- solver : facMax bounds the growth of the accepted steps
+   {
+      AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> s(rhsODEProblem<double>(
+                        [](const double , const double* y , double* dydt){ dydt[0] = y[1] ; dydt[1] = -y[0] ; } ,
+                        0.0 , 10.0 , 1.0e-6 , {1.0 , 0.0})) ;
+      s.setTolerances(1.0e-8 , 1.0e-8) ;
+      s.stepController().facMax = 1.5 ;
+      s.setQuiet(true) ;
+
+      std::vector<double> times ;
+      s.observe([&](const double t , const double* , const std::size_t){ times.push_back(t) ; }) ;
+
+      double ratio = 0 ;
+      for(std::size_t j=2 ; j + 1 < times.size() ; j++)                  // last step cut at tf
+         ratio = std::max(ratio , (times[j] - times[j-1]) / (times[j-1] - times[j-2])) ;
+      cout << "facMax 1.5 : largest ratio of steps " << ratio << " , " << s.rejected() << " rejected" << endl ;
+      check("solver : facMax 1.5 , steps grow by 1.5 at most" , ratio > 1.0 && ratio <= 1.5 * (1 + 1.0e-12)) ;
+   }
+
+   //-- blow up : step size too small
+   {
+      AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> s(rhsODEProblem<double>(
+                        [](const double , const double* y , double* dydt){ dydt[0] = y[0] * y[0] ; } ,
+                        0.0 , 2.0 , 0.01 , {1.0})) ;
+      s.setTolerances(1.0e-8 , 1.0e-8) ;
+      s.setQuiet(true) ;
+
+      string message ;
+      try { finalState(s) ; } catch(const std::runtime_error& e) { message = e.what() ; }
+      check("blow up at t = 1 : step size too small" , message.find("step size too small") != string::npos) ;
+   }
+
+   //-- tolerance , dense output
+   tolerances<DormandPrince5Tableau>      ("DP5(4)"  , 10) ;
+   tolerances<RungeKuttaFehlberg45Tableau>("RKF4(5)" , 1000) ;       // advances with the 4th order solution
+
+   denseOutput<DormandPrince5Tableau>      ("DP5(4)"  , 1.0e-10 , 100) ;
+   denseOutput<RungeKuttaFehlberg45Tableau>("RKF4(5)" , 1.0e-10 , 1000) ;
+
+   return testResult() ;
+}
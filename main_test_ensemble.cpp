@@ -0,0 +1,202 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <atomic>
+# include <stdexcept>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/ExplicitRungeKutta/AdaptiveRungeKuttaSolver.H"
+# include "Ensemble/EnsembleSolver.H"
+# include "Parallel/WorkStealingPool.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : ensembles (EnsembleSolver) and WorkStealingPool
+ *
+ *      damped oscillators y'' + c y' + w^2 y = 0 , 11 members (w , c) ,
+ *      4 lanes : the last batch is padded
+ *
+ *      - fixed step RK4 (SoA batch rhs) : the final state of one
+ *        RungeKutta4Solver per member , 0 and 3 workers
+ *      - adaptive DP5(4) : AdaptiveRungeKuttaSolver (Dormand-Prince)
+ *        with the same tolerances , and the exact solution
+ *      - mean() , variance() : decays y' = -k y (member rhs) against
+ *        the exact final values
+ *      - pool : an exception of a task is rethrown by parallelFor , the
+ *        pool runs the next parallelFor (every index once)
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+const std::size_t members = 11 ;
+
+double omega  (const std::size_t m) { return 1.0 + 0.1  * m ; }
+double damping(const std::size_t m) { return 0.1 + 0.02 * m ; }
+
+//-- y(0) = 1 , y'(0) = 0 (underdamped)
+double exactPosition(const std::size_t m , const double t)
+{
+   const double w = omega(m) , c = damping(m) ;
+   const double wd = std::sqrt(w*w - c*c/4) ;
+   return std::exp(-c*t/2) * (std::cos(wd*t) + c/(2*wd) * std::sin(wd*t)) ;
+}
+
+//-- SoA batch : u[i*L + l] , p = {w , c}
+auto oscillators = [](const double , const double* u , double* dudt , const double* p , const std::size_t L)
+                   {
+                      const double* y = u ;  const double* v = u + L ;
+                      const double* w = p ;  const double* c = p + L ;
+                      for(std::size_t l=0 ; l < L ; l++)
+                      {
+                         dudt[l]     = v[l] ;
+                         dudt[L + l] = -w[l]*w[l] * y[l] - c[l] * v[l] ;
+                      }
+                   };
+
+rhsODEProblem<double> member(const std::size_t m , const double tf , const double dt)
+{
+   const double w = omega(m) , c = damping(m) ;
+   return rhsODEProblem<double>([w , c](const double , const double* y , double* dydt)
+                                { dydt[0] = y[1] ; dydt[1] = -w*w * y[0] - c * y[1] ; } ,
+                                0.0 , tf , dt , {1.0 , 0.0}) ;
+}
+
+int main(){
+
+   const double tf = 5.0 , dt = 0.01 ;
+
+   EnsembleProblem<double> sweep(oscillators , 2 , 2 , 0.0 , tf , dt) ;
+   for(std::size_t m=0 ; m < members ; m++)
+      sweep.add({1.0 , 0.0} , {omega(m) , damping(m)}) ;
+
+   //-- fixed step
+   {
+      std::vector<std::vector<double>> single ;
+      for(std::size_t m=0 ; m < members ; m++)
+      {
+         RungeKutta4Solver<double> rk4(member(m , tf + dt/2 , dt)) ;        // record at tf
+         rk4.setQuiet(true) ;
+         single.push_back(finalState(rk4)) ;
+      }
+
+      EnsembleSolver<double , RungeKutta4Tableau> serial(sweep , 4 , 0) , threaded(sweep , 4 , 3) ;
+      serial.setQuiet(true) ;
+      threaded.setQuiet(true) ;
+      serial.solve() ;
+      threaded.solve() ;
+
+      double diff = 0 ;
+      for(std::size_t m=0 ; m < members ; m++)
+         for(std::size_t i=0 ; i < 2 ; i++)
+            diff = std::max(diff , std::abs(threaded.finalState(m)[i] - single[m][i])) ;
+      cout << "RK4 ensemble / RungeKutta4Solver : max |diff| " << diff << endl ;
+
+      check("RK4 : 3 batches of 4 lanes (last padded)" , threaded.batches() == 3 && threaded.finalStates().size() == 2*members) ;
+      check("RK4 : final states of RungeKutta4Solver" , diff < 1.0e-12) ;
+      check("RK4 : 0 and 3 workers give the same states" , serial.finalStates() == threaded.finalStates()) ;
+      check("RK4 : steps of the 3 batches" , threaded.accepted() == 3 * 500) ;
+   }
+
+   //-- adaptive
+   {
+      EnsembleSolver<double , DormandPrince5Tableau> ens(sweep , 4 , 3) ;
+      ens.setTolerances(1.0e-10 , 1.0e-10) ;
+      ens.setQuiet(true) ;
+      ens.solve() ;
+
+      double diff = 0 , error = 0 ;
+      for(std::size_t m=0 ; m < members ; m++)
+      {
+         AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> dp5(member(m , tf , dt)) ;
+         dp5.setTolerances(1.0e-10 , 1.0e-10) ;
+         dp5.setQuiet(true) ;
+         const std::vector<double> last = finalState(dp5) ;
+         for(std::size_t i=0 ; i < 2 ; i++)
+            diff = std::max(diff , std::abs(ens.finalState(m)[i] - last[i])) ;
+         error = std::max(error , std::abs(ens.finalState(m)[0] - exactPosition(m , tf))) ;
+      }
+
+      cout << "DP5 ensemble : max |diff| adaptive DormandPrince5 " << diff << " , error " << error
+           << " , " << ens.accepted() << " batch steps" << endl ;
+
+      check("DP5 adaptive : adaptive DormandPrince5 solution" , diff < 1.0e-8) ;
+      check("DP5 adaptive : exact solution" , error < 1.0e-8) ;
+      check("setTolerances : needs an embedded tableau" , [&]()
+            {
+               EnsembleSolver<double , RungeKutta4Tableau> rk4(sweep , 4 , 0) ;
+               try { rk4.setTolerances(1.0e-6 , 1.0e-6) ; } catch(const std::runtime_error&) { return true ; }
+               return false ;
+            }()) ;
+   }
+
+   //-- mean , variance
+   {
+      const std::size_t M = 7 ;
+      EnsembleProblem<double> decays([](const double , const double* u , double* dudt , const double* p)
+                                     { dudt[0] = -p[0] * u[0] ; } , 1 , 1 , 0.0 , 2.0 , 0.01) ;
+      std::vector<double> exact ;
+      for(std::size_t m=0 ; m < M ; m++)
+      {
+         const double k = 0.5 + 0.1 * m ;
+         decays.add({1.0} , {k}) ;
+         exact.push_back(std::exp(-2 * k)) ;
+      }
+      double mu = 0 , var = 0 ;
+      for(const double x : exact) mu += x / M ;
+      for(const double x : exact) var += (x - mu) * (x - mu) / (M - 1) ;
+
+      EnsembleSolver<double , RungeKutta4Tableau> ens(decays , 4 , 2) ;
+      ens.setQuiet(true) ;
+      ens.solve() ;
+
+      check("mean() : exact mean at tf" , std::abs(ens.mean()[0] - mu) < 1.0e-9) ;
+      check("variance() : exact sample variance at tf" , std::abs(ens.variance()[0] - var) < 1.0e-9) ;
+   }
+
+   //-- pool : exceptions , reuse
+   {
+      for(const std::size_t threads : { std::size_t(0) , std::size_t(3) })
+      {
+         WorkStealingPool pool(threads) ;
+
+         bool rethrown = false ;
+         try
+         {
+            pool.parallelFor(64 , [](const std::size_t i , const std::size_t)
+                             { if( i == 37 ) throw std::runtime_error("task 37") ; }) ;
+         }
+         catch(const std::runtime_error& e)
+         {
+            rethrown = std::string(e.what()) == "task 37" ;
+         }
+
+         std::vector<std::atomic<int>> visits(1000) ;
+         std::atomic<bool> workerInRange{true} ;
+         pool.parallelFor(visits.size() , [&](const std::size_t i , const std::size_t worker)
+                          {
+                             visits[i]++ ;
+                             if( worker >= pool.size() ) workerInRange = false ;
+                          }) ;
+         const bool once = std::all_of(visits.begin() , visits.end() , [](const std::atomic<int>& v){ return v == 1 ; }) ;
+
+         const string workers = " (" + std::to_string(threads) + " threads)" ;
+         check("pool : exception of a task rethrown" + workers , rethrown) ;
+         check("pool : reused after it , every index once" + workers , once && workerInRange) ;
+      }
+   }
+
+   return testResult() ;
+}
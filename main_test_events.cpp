@@ -0,0 +1,208 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include "rhsODEproblem.H"
+# include "Output/OutputSink.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/DormandPrince/DormandPrince5Solver.H"
+# include "RungeKutta/ExplicitRungeKutta/AdaptiveRungeKuttaSolver.H"
+# include "MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth4thSolver.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : events (OdeSolver::addEvent)
+ *
+ *      - free fall , terminate on the ground : exact time , state ,
+ *        no record after it
+ *      - bouncing ball , modify (v <- -e v) and restart : the bounce
+ *        times of the exact solution (RK4 , adaptive DP5 , AB4)
+ *      - direction filter on cos(t)
+ *      - Lorenz Poincare section z = 27 , only the events written ,
+ *        crossings against a 10x finer run
+ *      - y' = -y on BDF , terminate at y = 1/2 (t = ln 2)
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+const double gravity = 9.81 ;
+
+auto fall = [](const double , const double* y , double* dydt)
+            {
+               dydt[0] = y[1] ;
+               dydt[1] = -gravity ;
+            };
+
+auto lorenz = [](const double , const double* y , double* dydt)
+              {
+                 dydt[0] = 10.0 * (y[1] - y[0]) ;
+                 dydt[1] = 28.0 * y[0] - y[1] - y[0] * y[2] ;
+                 dydt[2] = -8.0/3.0 * y[2] + y[0] * y[1] ;
+              };
+
+
+//-- ground at 0 , restitution e : bounce times of the exact solution from height h0 at rest
+std::vector<double> bounceTimes(const double h0 , const double e , const std::size_t count)
+{
+   std::vector<double> times ;
+   double t = std::sqrt(2 * h0 / gravity) , v = gravity * t ;
+   for(std::size_t k=0 ; k < count ; k++)
+   {
+      times.push_back(t) ;
+      v *= e ;
+      t += 2 * v / gravity ;
+   }
+   return times ;
+}
+
+
+template <typename Solver>
+bool bounces(Solver& s , const double tol)
+{
+   s.addEvent([](const double , const double* y){ return y[0] ; } , EventDirection::falling , EventAction::modify ,
+              [](const double , double* y){ y[0] = 0 ; y[1] = -0.9 * y[1] ; }) ;
+   NullSink<double> out ;
+   s.solve(out) ;
+
+   const auto exact = bounceTimes(10.0 , 0.9 , 4) ;               // the 5th after tf
+   bool ok = s.events().size() >= exact.size() && !s.terminated() ;
+   for(std::size_t k=0 ; ok && k < exact.size() ; k++)
+      ok = std::abs(s.events()[k].t - exact[k]) < tol && s.events()[k].direction == EventDirection::falling ;
+   return ok ;
+}
+
+
+int main(){
+
+   const rhsODEProblem<double> ball(fall , 0.0 , 10.0 , 1.0e-2 , {10.0 , 0.0}) ;
+
+   //-- terminate
+   {
+      RungeKutta4Solver<double> rk4(ball) ;
+      rk4.setQuiet(true) ;
+      rk4.addEvent([](const double , const double* y){ return y[0] ; } , EventDirection::falling , EventAction::terminate) ;
+      double last = 0 ;
+      std::size_t records = 0 ;
+      rk4.observe([&](const double t , const double* , const std::size_t){ last = t ; records++ ; }) ;
+
+      const double exact = std::sqrt(2 * 10.0 / gravity) ;
+      check("terminate : event time" , rk4.terminated() && rk4.events().size() == 1 &&
+                                       std::abs(rk4.events()[0].t - exact) < 1.0e-12) ;
+      check("terminate : last record is the event , no more steps" ,
+            last == rk4.events()[0].t && records == std::size_t(std::floor(exact / 0.01)) + 2) ;
+      check("terminate : state at the event" , std::abs(rk4.events()[0].u[0]) < 1.0e-12 &&
+                                               std::abs(rk4.events()[0].u[1] + gravity * exact) < 1.0e-10) ;
+      check("terminate : counted" , !SolverStats::enabled || rk4.statistics().events == 1) ;
+   }
+
+   //-- modify and restart
+   {
+      RungeKutta4Solver<double> rk4(ball) ;
+      AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> dp5(ball) ;
+      dp5.setTolerances(1.0e-10 , 1.0e-10) ;
+      AdamsBashforth4thSolver<double> ab4(ball) ;
+      rk4.setQuiet(true) ;
+      dp5.setQuiet(true) ;
+      ab4.setQuiet(true) ;
+      const bool a = bounces(rk4 , 1.0e-10) , b = bounces(dp5 , 1.0e-8) , c = bounces(ab4 , 1.0e-9) ;
+
+      check("bouncing ball : RungeKutta4" , a) ;
+      check("bouncing ball : DormandPrince5 (adaptive)" , b) ;
+      check("bouncing ball : AdamsBashforth4 (history restarted)" , c) ;
+   }
+
+   //-- direction filter : x = cos t on [0 , 20] , falling at pi/2 + 2 pi k , rising at 3 pi/2 + 2 pi k
+   {
+      const rhsODEProblem<double> osc([](const double , const double* y , double* dydt){ dydt[0] = y[1] ; dydt[1] = -y[0] ; } ,
+                                      0.0 , 20.0 , 1.0e-2 , {1.0 , 0.0}) ;
+      RungeKutta4Solver<double> rk4(osc) ;
+      rk4.setQuiet(true) ;
+      const auto x = [](const double , const double* y){ return y[0] ; } ;
+      rk4.addEvent(x , EventDirection::rising) ;
+      rk4.addEvent(x , EventDirection::falling) ;
+      rk4.addEvent(x , EventDirection::both) ;
+      NullSink<double> out ;
+      rk4.solve(out) ;
+
+      std::size_t count[3] = {0 , 0 , 0} ;
+      bool ok = true ;
+      for(const auto& e : rk4.events())
+      {
+         count[e.event]++ ;
+         const double k = std::round((e.t - M_PI/2) / M_PI) ;
+         ok = ok && std::abs(e.t - (M_PI/2 + k*M_PI)) < 1.0e-8 &&
+              (e.direction == EventDirection::rising) == (int(k) % 2 == 1) ;
+      }
+      check("direction filter : rising 3 , falling 3 , both 6" , ok && count[0] == 3 && count[1] == 3 && count[2] == 6) ;
+      check("records in time order" , std::is_sorted(rk4.events().begin() , rk4.events().end() ,
+                                      [](const auto& a , const auto& b){ return a.t < b.t ; })) ;
+   }
+
+   //-- Poincare section of Lorenz , only the events written
+   {
+      const rhsODEProblem<double> coarse(lorenz , 0.0 , 20.0 , 1.0e-3 , {1.0 , 1.0 , 1.0}) ;
+      const rhsODEProblem<double> fine  (lorenz , 0.0 , 20.0 , 1.0e-4 , {1.0 , 1.0 , 1.0}) ;
+      const auto plane = [](const double , const double* y){ return y[2] - 27.0 ; } ;
+
+      RungeKutta4Solver<double> a(coarse) , b(fine) ;
+      a.setQuiet(true) ;
+      b.setQuiet(true) ;
+      a.addEvent(plane , EventDirection::rising) ;
+      b.addEvent(plane , EventDirection::rising) ;
+      a.setEventsOnly(true) ;
+      b.setEventsOnly(true) ;
+      NullSink<double> outA , outB ;
+      a.solve(outA) ;
+      b.solve(outB) ;
+
+      const std::size_t m = std::min<std::size_t>(5 , std::min(a.events().size() , b.events().size())) ;
+      double dt = 0 ;
+      for(std::size_t k=0 ; k < m ; k++)
+         dt = std::max(dt , std::abs(a.events()[k].t - b.events()[k].t)) ;
+      cout << "Lorenz z = 27 : " << a.events().size() << " crossings , first 5 within " << dt << endl ;
+
+      check("Poincare section : only the events written" , outA.records() == a.events().size() && a.events().size() > 10) ;
+      check("Poincare section : first crossings against dt/10" , m == 5 && dt < 1.0e-8) ;
+   }
+
+   //-- implicit , adaptive : y' = -y , y = 1/2 at ln 2
+   {
+      const rhsODEProblem<double> decay([](const double , const double* y , double* dydt){ dydt[0] = -y[0] ; } ,
+                                        0.0 , 10.0 , 1.0e-3 , {1.0}) ;
+      BDFSolver<double> bdf(decay) ;
+      bdf.setQuiet(true) ;
+      bdf.setTolerances(1.0e-10 , 1.0e-10) ;
+      bdf.addEvent([](const double , const double* y){ return y[0] - 0.5 ; } , EventDirection::falling , EventAction::terminate) ;
+      NullSink<double> out ;
+      bdf.solve(out) ;
+
+      check("BDF : terminate at ln 2" , bdf.terminated() && bdf.events().size() == 1 &&
+                                        std::abs(bdf.events()[0].t - std::log(2.0)) < 1.0e-7) ;
+   }
+
+   //-- no event : nothing changes
+   {
+      RungeKutta4Solver<double> rk4(ball) ;
+      rk4.setQuiet(true) ;
+      NullSink<double> a , b ;
+      rk4.solve(a) ;
+      rk4.addEvent([](const double , const double* y){ return y[0] + 1.0e6 ; }) ;
+      rk4.solve(b) ;
+      rk4.clearEvents() ;
+
+      check("events that never cross : same records" , a.records() == b.records() && rk4.events().empty() && !rk4.terminated()) ;
+   }
+
+   return testResult() ;
+}
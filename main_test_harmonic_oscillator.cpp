@@ -69,9 +69,19 @@ int main()
    heun1.solve("HeunSystem_oscillator.out"); 
 
    RungeKutta4Solver<double> rk4_1(p1);
-   rk4_1.solve("RK4System_oscillator.out");   
+   rk4_1.solve("RK4System_oscillator.out");
+
+   //-- same run kept in memory , and streamed to an observer (no file)
+   const auto traj = rk4_1.trajectory() ;
+   const auto x    = traj.component(0) ;
+   cout << "RK4 records " << traj.size() << " , x(tf) = " << x[x.size()-1] << endl ;
+
+   AdamsBashforth2ndSolver<double> ab2_1(p1);
+   double energyMax = 0.0 ;
+   ab2_1.observe([&](const double t , const double* u , const std::size_t n)
+                 { energyMax = std::max(energyMax , 0.5*(u[0]*u[0] + u[1]*u[1])) ; });
+   cout << "AB2 max energy " << energyMax << endl ;
 
-   
    
   return 0;    
 
@@ -0,0 +1,143 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <limits>
+# include <algorithm>
+# include "Kernels/LinearCombination.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : fused linear combination kernels
+ *             (Kernels/LinearCombination.H)
+ *
+ *      y = u + sum_j c_j k_j , every instruction set of the CPU forced
+ *      by kernel::setIsa , float and double , against the same sum in
+ *      long double :
+ *
+ *      - m = 0 .. 8 terms , and 20 (two chained passes)
+ *      - base u , no base (u = nullptr) , in place (y = u)
+ *      - n = 0 .. 40 and 257 : every tail of the 2 x W register loop
+ *        and of the scalar blocks
+ *
+ *      the error bound is a few ulps of sum |terms| (fma or not)
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+enum class Base { given , none , inPlace } ;
+
+//-- max error / (eps sum |terms|) over the components , -1 if the base is touched
+template <typename Type>
+double worst(const std::size_t n , const std::size_t m , const Base base)
+{
+   std::vector<std::vector<Type>> k(m , std::vector<Type>(n)) ;
+   std::vector<Type>        c(m) , u(n) , y(n , Type(-7)) ;
+   std::vector<const Type*> kp(m) ;
+
+   for(std::size_t j=0 ; j < m ; j++)
+   {
+      c[j]  = Type(0.5 + 0.37 * j) * (j % 2 ? -1 : 1) ;
+      kp[j] = k[j].data() ;
+      for(std::size_t i=0 ; i < n ; i++)
+         k[j][i] = Type(std::sin(1.0 + i + 13.0 * j)) ;
+   }
+   for(std::size_t i=0 ; i < n ; i++)
+      u[i] = Type(std::cos(0.5 * i)) ;
+   const std::vector<Type> u0 = u ;
+
+   Type*       out  = base == Base::inPlace ? u.data() : y.data() ;
+   const Type* from = base == Base::none    ? nullptr  : u.data() ;
+   kernel::linearCombination(out , from , n , c.data() , kp.data() , m) ;
+
+   if( base == Base::given && u != u0 )
+      return -1 ;
+
+   double err = 0 ;
+   for(std::size_t i=0 ; i < n ; i++)
+   {
+      long double exact = base == Base::none ? 0 : u0[i] , scale = std::abs(exact) ;
+      for(std::size_t j=0 ; j < m ; j++)
+      {
+         exact += (long double)c[j] * k[j][i] ;
+         scale += std::abs((long double)c[j] * k[j][i]) ;
+      }
+      const long double eps = std::numeric_limits<Type>::epsilon() ;
+      err = std::max(err , double(std::abs(out[i] - exact) / (eps * std::max(scale , 1.0L)))) ;
+   }
+   return err ;
+}
+
+
+template <typename Type>
+void kernels(const string& type)
+{
+   const std::vector<std::size_t> terms{ 0 , 1 , 2 , 3 , 4 , 5 , 6 , 7 , 8 , 20 } ;
+   std::vector<std::size_t> sizes ;
+   for(std::size_t n=0 ; n <= 40 ; n++) sizes.push_back(n) ;
+   sizes.push_back(257) ;
+
+   for(const kernel::Isa i : { kernel::Isa::scalar , kernel::Isa::avx2 , kernel::Isa::avx512 })
+   {
+      kernel::setIsa(i) ;
+      const string name = type + " " + kernel::isaName(i) ;
+      if( kernel::isa() != i )
+      {
+         cout << name << " : not supported by this CPU" << endl ;
+         continue ;
+      }
+
+      double given = 0 , none = 0 , inPlace = 0 ;
+      bool   untouched = true ;
+      for(const std::size_t m : terms)
+         for(const std::size_t n : sizes)
+         {
+            const double g = worst<Type>(n , m , Base::given) ;
+            untouched = untouched && g >= 0 ;
+            given     = std::max(given   , g) ;
+            none      = std::max(none    , worst<Type>(n , m , Base::none)) ;
+            inPlace   = std::max(inPlace , worst<Type>(n , m , Base::inPlace)) ;
+         }
+      cout << name << " : error / (eps sum |terms|) " << given << " , " << none << " , " << inPlace << endl ;
+
+      check(name + " : base u , m = 0..8 , 20 , every tail" , untouched && given < 4) ;
+      check(name + " : no base (u = nullptr)" , none < 4) ;
+      check(name + " : in place (y = u)" , inPlace < 4) ;
+   }
+   kernel::setIsa(kernel::detectIsa()) ;
+}
+
+
+int main(){
+
+   cout << "detected isa : " << kernel::isaName(kernel::detectIsa()) << endl ;
+
+   kernels<double>("double") ;
+   kernels<float> ("float") ;
+
+   //-- setIsa never goes above the CPU
+   kernel::setIsa(kernel::Isa::avx512) ;
+   check("setIsa : not above the detected instruction set" , kernel::isa() == kernel::detectIsa()) ;
+
+   //-- combine , weightedSum on the selected kernel
+   {
+      std::vector<double> y(19) , u(19 , 1.0) , a(19 , 2.0) , b(19 , 3.0) ;
+      kernel::combine(y , u , 0.5 , a , -1.0 , b) ;
+      const bool combined = std::all_of(y.begin() , y.end() , [](const double v){ return v == -1.0 ; }) ;
+      kernel::weightedSum(y , 0.5 , a , -1.0 , b) ;
+      const bool weighted = std::all_of(y.begin() , y.end() , [](const double v){ return v == -2.0 ; }) ;
+      check("combine , weightedSum" , combined && weighted) ;
+   }
+
+   return testResult() ;
+}
@@ -0,0 +1,228 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <chrono>
+# include <memory>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "Euler/BackwardEulerSolver.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "Implicit/DenseLinearSolver.H"
+# include "Implicit/BandedLinearSolver.H"
+# include "Implicit/SparseLinearSolver.H"
+# include "Implicit/MatrixFreeLinearSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : linear solver backends of the implicit solvers
+ *
+ *      Fisher-KPP by the method of lines , u_t = d lap(u) + u (1 - u) ,
+ *      zero boundary values , 1D (3 point) and 2D (5 point) grids
+ *
+ *      - small grids : banded , sparse LU , ILU(0) GMRES and matrix free
+ *        GMRES give the solution of the dense LU (backward Euler , BDF)
+ *      - analytic sparse Jacobian against the colored finite differences
+ *      - 10^5 unknowns : memory of the backend ~ nonzeros (the dense LU
+ *        would need 2 10^10 values) , with and without a pool of workers
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+//-- m points per side , dim 1 or 2 ; pattern rows in a shuffled order (not sorted)
+rhsODEProblem<double> fisher(const std::size_t m , const int dim , const double tf , const double dt ,
+                             const bool analytic)
+{
+   const std::size_t n = dim == 1 ? m : m*m ;
+   const double      h = 1.0 / (m + 1) ;
+   const double      c = 0.1 / (h*h) ;
+
+   auto neighbours = [m , dim](const std::size_t i)
+   {
+      std::vector<std::size_t> r{i} ;
+      const std::size_t a = dim == 1 ? i : i % m ;
+      if( a + 1 < m ) r.push_back(i + 1) ;
+      if( a > 0 )     r.push_back(i - 1) ;
+      if( dim == 2 )
+      {
+         if( i + m < m*m ) r.push_back(i + m) ;
+         if( i >= m )      r.push_back(i - m) ;
+      }
+      return r ;
+   };
+
+   std::valarray<double> u0(n) ;
+   for(std::size_t i=0 ; i < n ; i++)
+   {
+      const double x = (dim == 1 ? i : i % m) + 1.0 , y = (dim == 1 ? 0 : i / m) + 1.0 ;
+      u0[i] = std::sin(M_PI * x * h) * (dim == 1 ? 1.0 : std::sin(M_PI * y * h)) ;
+   }
+
+   rhsODEProblem<double> p([n , c , dim , neighbours](const double , const double* u , double* dudt)
+                           {
+                              for(std::size_t i=0 ; i < n ; i++)
+                              {
+                                 const auto r = neighbours(i) ;
+                                 double lap = -2.0 * dim * u[i] ;
+                                 for(std::size_t k=1 ; k < r.size() ; k++)
+                                    lap += u[r[k]] ;
+                                 dudt[i] = c * lap + u[i] * (1 - u[i]) ;
+                              }
+                           } , 0.0 , tf , dt , u0) ;
+
+   std::vector<std::vector<std::size_t>> rows(n) ;
+   for(std::size_t i=0 ; i < n ; i++)
+      rows[i] = neighbours(i) ;
+   p.setSparsity(rows) ;
+
+   if( analytic )
+      p.setSparseJacobian([n , c , dim , neighbours](const double , const double* u , double* values)
+                          {
+                             std::size_t k = 0 ;
+                             for(std::size_t i=0 ; i < n ; i++)
+                             {
+                                const auto r = neighbours(i) ;
+                                values[k++] = -2.0 * dim * c + 1 - 2 * u[i] ;
+                                for(std::size_t j=1 ; j < r.size() ; j++)
+                                   values[k++] = c ;
+                             }
+                          }) ;
+   return p ;
+}
+
+
+//-- backward Euler with the backend , final state and the backend memory
+std::vector<double> backwardEuler(const rhsODEProblem<double>& p , const LinearSolver<double>& backend ,
+                                  std::size_t& storage)
+{
+   BackwardEulerSolver<double> be(p) ;
+   be.setQuiet(true) ;
+   be.nonlinearSolver().setLinearSolver(backend) ;
+   auto last = finalState(be) ;
+   storage = be.nonlinearSolver().linearSolver().storage() ;
+   return last ;
+}
+
+
+int main(){
+
+   std::size_t storage = 0 ;
+
+   using Sparse = SparseLinearSolver<double> ;
+
+   //-- small grids : every backend against the dense LU
+   for(int dim=1 ; dim <= 2 ; dim++)
+   {
+      const std::size_t m = dim == 1 ? 60 : 12 ;
+      const auto p = fisher(m , dim , 0.05 , 5.0e-3 , false) ;
+
+      const auto dense   = backwardEuler(p , DenseLinearSolver<double>() , storage) ;
+      const auto banded  = backwardEuler(p , BandedLinearSolver<double>(dim == 1 ? 1 : m , dim == 1 ? 1 : m) , storage) ;
+      const auto direct  = backwardEuler(p , Sparse(Sparse::Method::direct) , storage) ;
+      const auto gmres   = backwardEuler(p , Sparse(Sparse::Method::gmres) , storage) ;
+      const auto jfnk    = backwardEuler(p , MatrixFreeLinearSolver<double>() , storage) ;
+
+      const string grid = dim == 1 ? "1D : " : "2D : " ;
+      check(grid + "banded LU = dense LU"        , maxDifference(banded , dense) < 1.0e-12) ;
+      check(grid + "sparse LU = dense LU"        , maxDifference(direct , dense) < 1.0e-12) ;
+      check(grid + "ILU(0) GMRES ~ dense LU"     , maxDifference(gmres  , dense) < 1.0e-8) ;
+      check(grid + "matrix free GMRES ~ dense LU", maxDifference(jfnk   , dense) < 1.0e-7) ;
+   }
+
+   //-- BDF (variable order and step) , analytic sparse Jacobian
+   {
+      const auto fd = fisher(12 , 2 , 0.2 , 1.0e-3 , false) ;
+      const auto an = fisher(12 , 2 , 0.2 , 1.0e-3 , true) ;
+
+      BDFSolver<double> a(fd) , b(an) , c(an) ;
+      a.setTolerances(1.0e-6 , 1.0e-6) ;
+      b.setTolerances(1.0e-6 , 1.0e-6) ;
+      c.setTolerances(1.0e-6 , 1.0e-6) ;
+      for(auto* s : { &a , &b , &c })
+         s->setQuiet(true) ;
+      b.nonlinearSolver().setLinearSolver(Sparse(Sparse::Method::direct)) ;
+      c.nonlinearSolver().setLinearSolver(Sparse(Sparse::Method::gmres)) ;
+      const auto ua = finalState(a) , ub = finalState(b) , uc = finalState(c) ;
+
+      check("BDF : sparse LU , analytic J ~ dense LU , differences" , maxDifference(ub , ua) < 1.0e-6) ;
+      check("BDF : ILU(0) GMRES ~ dense LU" , maxDifference(uc , ua) < 1.0e-6) ;
+      check("BDF : GMRES iterations counted" , !SolverStats::enabled || c.statistics().linearIterations > 0) ;
+   }
+
+   //-- 10^5 unknowns
+   const std::size_t n1 = 100000 , m2 = 316 ;
+   const auto line  = fisher(n1 , 1 , 1.0e-3 , 2.5e-4 , false) ;
+   const auto plane = fisher(m2 , 2 , 1.0e-3 , 2.5e-4 , false) ;
+   const auto pool  = std::make_shared<WorkStealingPool>(4) ;
+
+   auto timed = [&](const rhsODEProblem<double>& p , LinearSolver<double>&& backend , const bool parallel ,
+                    std::size_t& values , double& seconds)
+   {
+      if( parallel ) backend.setPool(pool) ;
+      const auto start = std::chrono::steady_clock::now() ;
+      auto last = backwardEuler(p , backend , values) ;
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() ;
+      return last ;
+   };
+
+   cout << endl << setw(34) << left << "backend" << setw(10) << right << "n" << setw(14) << "values/n"
+        << setw(12) << "serial s" << setw(12) << "pool s" << endl ;
+
+   auto report = [&](const string& what , const std::size_t n , const std::size_t values , const double s1 , const double s4)
+   {
+      cout << setw(34) << left << what << setw(10) << right << n << setw(14) << double(values)/n
+           << setw(12) << s1 << setw(12) << s4 << endl ;
+   };
+
+   {
+      std::size_t v1 , v4 ;
+      double      s1 , s4 ;
+      const auto a = timed(line , BandedLinearSolver<double>(1 , 1) , false , v1 , s1) ;
+      const auto b = timed(line , BandedLinearSolver<double>(1 , 1) , true  , v4 , s4) ;
+      report("1D banded LU" , n1 , v1 , s1 , s4) ;
+
+      std::size_t w1 , w4 ;
+      double      t1 , t4 ;
+      const auto c = timed(line , Sparse(Sparse::Method::direct) , false , w1 , t1) ;
+      const auto d = timed(line , Sparse(Sparse::Method::direct) , true  , w4 , t4) ;
+      report("1D sparse LU" , n1 , w1 , t1 , t4) ;
+
+      check("1D 10^5 : banded memory ~ 7 n (J + LU band)" , v1 <= 8 * n1 && v1 == v4) ;
+      check("1D 10^5 : sparse LU memory ~ nonzeros" , w1 <= 8 * n1) ;
+      check("1D 10^5 : pool gives the serial solution" , maxDifference(a , b) == 0 && maxDifference(c , d) < 1.0e-12) ;
+      check("1D 10^5 : sparse LU = banded LU" , maxDifference(a , c) < 1.0e-10) ;
+   }
+
+   {
+      const std::size_t n2 = m2 * m2 ;
+      std::size_t v1 , v4 ;
+      double      s1 , s4 ;
+      const auto a = timed(plane , Sparse(Sparse::Method::gmres) , false , v1 , s1) ;
+      const auto b = timed(plane , Sparse(Sparse::Method::gmres) , true  , v4 , s4) ;
+      report("2D ILU(0) GMRES" , n2 , v1 , s1 , s4) ;
+
+      std::size_t w1 , w4 ;
+      double      t1 , t4 ;
+      const auto c = timed(plane , MatrixFreeLinearSolver<double>() , false , w1 , t1) ;
+      const auto d = timed(plane , MatrixFreeLinearSolver<double>() , true  , w4 , t4) ;
+      report("2D matrix free GMRES" , n2 , w1 , t1 , t4) ;
+
+      check("2D 10^5 : ILU(0) GMRES memory ~ (restart + 15) n" , v1 <= 48 * n2) ;
+      check("2D 10^5 : matrix free memory ~ (restart + 8) n" , w1 <= 40 * n2) ;
+      check("2D 10^5 : pool ~ serial (sums in other blocks)" , maxDifference(a , b) < 1.0e-8 && maxDifference(c , d) < 1.0e-7) ;
+      check("2D 10^5 : ILU(0) GMRES ~ matrix free" , maxDifference(a , c) < 1.0e-6) ;
+   }
+
+   return testResult() ;
+}
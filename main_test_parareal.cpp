@@ -0,0 +1,166 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <algorithm>
+# include <sstream>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "Euler/ForwardEulerSolver.H"
+# include "RungeKutta/Heun/HeunSolver.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/RungeKuttaFehlberg/RungeKuttaFehlberg45Solver.H"
+# include "Parareal/PararealSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : Parareal (PararealSolver)
+ *
+ *      Van der Pol (mu = 1) on [0 , 20] , 16 windows
+ *
+ *      - Heun coarse , RK4 fine : converged to the serial RK4 run in
+ *        a few iterations , corrections decreasing
+ *      - no tolerance : windows iterations , the serial RK4 solution
+ *      - 1 and 4 workers give the same records
+ *      - fine output : every record of the serial run
+ *      - forward Euler coarse , adaptive RKF45 fine (configureFine)
+ *      - the window solvers do not print (setQuiet)
+ *      - setWindow / clearWindow : expected records of the window
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto vanDerPol = [](const double , const double* y , double* dydt)
+                 {
+                    dydt[0] = y[1] ;
+                    dydt[1] = (1 - y[0]*y[0]) * y[1] - y[0] ;
+                 };
+
+
+struct Records
+{
+   std::vector<double> t , u ;
+};
+
+template <typename Solver>
+Records records(Solver& s)
+{
+   Records r ;
+   ObserverSink<double> out([&r](const double t , const double* u , const std::size_t n)
+                            { r.t.push_back(t) ; r.u.insert(r.u.end() , u , u + n) ; }) ;
+   s.solve(out) ;
+   return r ;
+}
+
+
+int main(){
+
+   const rhsODEProblem<double> p(vanDerPol , 0.0 , 20.0 , 1.0e-3 , {2.0 , 0.0}) ;
+
+   using Parareal = PararealSolver<double , HeunSolver<double> , RungeKutta4Solver<double>> ;
+
+   //-- serial RK4 up to tf + dt/2 : t += dt may miss the record at t = 20
+   const rhsODEProblem<double> q(vanDerPol , 0.0 , 20.0 + 0.5e-3 , 1.0e-3 , {2.0 , 0.0}) ;
+   RungeKutta4Solver<double> serial(q) ;
+   serial.setQuiet(true) ;
+   const Records exact = records(serial) ;
+
+   const std::size_t end  = exact.t.size() - 1 ;
+   const double*     uEnd = &exact.u[2*end] ;
+   check("serial RK4 : record at t = 20" , end == 20000 && std::abs(exact.t[end] - 20.0) < 1.0e-9) ;
+
+   //-- window of a solver : records and preallocation of [5 , 6]
+   {
+      RungeKutta4Solver<double> s(p) ;
+      s.setQuiet(true) ;
+      s.setWindow(5.0 , 6.0 + 0.5e-3 , {2.0 , 0.0}) ;
+      const std::size_t hint = s.expectedRecords() ;
+      const Records r = records(s) ;
+      s.clearWindow() ;
+
+      check("window : expected records of the window" , r.t.size() == 1001 && hint >= r.t.size() && hint <= r.t.size() + 2) ;
+      check("clearWindow : expected records of the problem" , s.expectedRecords() == 20002) ;
+   }
+
+   //-- converged
+   {
+      std::ostringstream log ;
+      std::streambuf* console = cout.rdbuf(log.rdbuf()) ;
+      Parareal pr(p , 16 , 0.05 , 4) ;
+      pr.setTolerances(1.0e-9 , 1.0e-9) ;
+      const Records r = records(pr) ;
+      cout.rdbuf(console) ;
+
+      const auto& info = pr.pararealStatistics() ;
+      cout << "Parareal : " << info.iterations << " iterations , corrections" ;
+      for(const double c : info.corrections) cout << " " << c ;
+      cout << endl ;
+
+      const string text = log.str() ;
+      check("quiet window solvers : Running / Done of Parareal only" , std::count(text.begin() , text.end() , '\n') == 2) ;
+      check("converged in fewer iterations than windows" , pr.converged() && pr.iterations() < 16) ;
+      check("boundary records : windows + 1 , end at tf" , r.t.size() == 17 && std::abs(r.t.back() - 20.0) < 1.0e-12) ;
+      check("final state = serial RK4" , maxDifference(&r.u[32] , uEnd , 2) < 1.0e-7) ;
+      check("corrections decrease" , info.corrections.size() < 2 ||
+                                     info.corrections.back() < info.corrections.front()) ;
+      check("statistics : coarse and fine work" , !SolverStats::enabled ||
+                                                  pr.statistics().rhsEvaluations > serial.statistics().rhsEvaluations) ;
+   }
+
+   //-- no tolerance : every window exact after windows iterations
+   {
+      Parareal a(p , 8 , 0.5 , 1) , b(p , 8 , 0.5 , 4) ;
+      a.setTolerances(0 , 0) ;
+      b.setTolerances(0 , 0) ;
+      a.setQuiet(true) ;
+      b.setQuiet(true) ;
+      const Records ra = records(a) , rb = records(b) ;
+
+      check("no tolerance : windows iterations" , a.iterations() == 8 && a.converged()) ;
+      check("no tolerance : the serial RK4 solution" , maxDifference(&ra.u[16] , uEnd , 2) < 1.0e-10) ;
+      check("1 and 4 workers : same records" , ra.u == rb.u && ra.t == rb.t) ;
+   }
+
+   //-- fine output
+   {
+      Parareal pr(p , 16 , 0.05 , 4) ;
+      pr.setTolerances(1.0e-9 , 1.0e-9) ;
+      pr.setFineOutput(true) ;
+      pr.setQuiet(true) ;
+      const Records r = records(pr) ;
+
+      bool ok = r.t.size() == end + 1 ;
+      for(std::size_t k=0 ; ok && k <= end ; k++)
+         ok = std::abs(r.t[k] - exact.t[k]) < 1.0e-9 && maxDifference(&r.u[2*k] , &exact.u[2*k] , 2) < 1.0e-7 ;
+      check("fine output : the records of the serial run" , ok) ;
+   }
+
+   //-- adaptive fine
+   {
+      RungeKuttaFehlberg45Solver<double> rkf(p) ;
+      rkf.setTolerances(1.0e-10 , 1.0e-10) ;
+      rkf.setQuiet(true) ;
+      const Records ref = records(rkf) ;
+
+      PararealSolver<double , ForwardEulerSolver<double> , RungeKuttaFehlberg45Solver<double>> pr(p , 10 , 0.01 , 4) ;
+      pr.configureFine([](RungeKuttaFehlberg45Solver<double>& s){ s.setTolerances(1.0e-10 , 1.0e-10) ; }) ;
+      pr.setTolerances(1.0e-8 , 1.0e-8) ;
+      pr.setQuiet(true) ;
+      const Records r = records(pr) ;
+
+      check("RKF45 fine : converged , ends at tf" , pr.converged() && r.t.back() == 20.0 && ref.t.back() == 20.0) ;
+      check("RKF45 fine : serial RKF45 solution" , maxDifference(&r.u[r.u.size()-2] , &ref.u[ref.u.size()-2] , 2) < 1.0e-6) ;
+   }
+
+   return testResult() ;
+}
@@ -0,0 +1,141 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include "rhsODEproblem.H"
+# include "Precision.H"
+# include "Output/ObserverSink.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/ExplicitRungeKutta/MixedPrecisionRungeKuttaSolver.H"
+# include "MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth4thSolver.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : precision of Type , compensated and mixed precision
+ *
+ *      y' = -y/10 on [0 , 10] , dt = 1e-4 (10^5 steps) : the RK4
+ *      truncation error is ~ 1e-19 , what is left is rounding
+ *
+ *      - tolerances , step counts , finite differences follow the
+ *        epsilon of Type (float)
+ *      - compensated summation : record at t = 10 , state error of
+ *        float RK4 and AB4
+ *      - mixed precision : float stages / double state , double
+ *        stages / long double state
+ *      - BDF in float (tolerances of float)
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+template <typename Type>
+rhsODEProblem<Type> slowDecay(const Type dt)
+{
+   return rhsODEProblem<Type>([](const Type , const Type* y , Type* dydt){ dydt[0] = -y[0] / 10 ; } ,
+                              Type(0) , Type(10) , dt , {Type(1)}) ;
+}
+
+
+//-- time of the last record , |y - exact| there (exact in long double)
+struct Last { long double t = 0 ; long double error = 0 ; std::size_t records = 0 ; } ;
+
+template <typename Solver>
+Last last(Solver& s)
+{
+   Last r ;
+   s.observe([&r](const auto t , const auto* y , const std::size_t)
+             {
+                r.t     = t ;
+                r.error = std::abs(static_cast<long double>(y[0]) - std::exp(-static_cast<long double>(t) / 10)) ;
+                r.records++ ;
+             }) ;
+   return r ;
+}
+
+
+int main(){
+
+   std::streambuf* console = cout.rdbuf() ;
+
+   //-- precision of Type
+   {
+      check("tolerance : 1e-6 in double , 100 eps in float" ,
+            precision::tolerance(1.0e-6) == 1.0e-6 && precision::tolerance(1.0e-6f) == 100 * precision::epsilon<float>()) ;
+      check("scaled : 1e-12 in double , same ulps in float" ,
+            precision::scaled<double>(1.0e-12) == 1.0e-12 &&
+            std::abs(precision::scaled<float>(1.0e-12) - 5.4e-4f) < 1.0e-5f) ;
+      check("whole steps : 1 / 1e-3 in float is 1000" , precision::wholeSteps(1.0f , 1.0e-3f) == 1000 &&
+                                                       precision::coveringSteps(1.0f , 1.0e-3f) == 1000) ;
+
+      const rhsODEProblem<float> p([](const float , const float* y , float* dydt){ dydt[0] = -2 * y[0] * y[0] ; } ,
+                                   0.0f , 1.0f , 0.1f , {3.0f}) ;
+      check("finite difference in float : df/du = -4 u" , std::abs(p.dfdt(0 , 0.0f , p.u0()) + 12.0f) < 1.0e-2f) ;
+   }
+
+   //-- compensated summation , float
+   {
+      cout.rdbuf(nullptr) ;
+      RungeKutta4Solver<float> a(slowDecay<float>(1.0e-4f)) , b(slowDecay<float>(1.0e-4f)) ;
+      b.setCompensatedSummation(true) ;
+      const Last plain = last(a) , comp = last(b) ;
+
+      AdamsBashforth4thSolver<float> c(slowDecay<float>(1.0e-4f)) , d(slowDecay<float>(1.0e-4f)) ;
+      d.setCompensatedSummation(true) ;
+      const Last ab = last(c) , abComp = last(d) ;
+      cout.rdbuf(console) ;
+
+      cout << "float RK4 : t " << double(plain.t) << " error " << double(plain.error)
+           << " , compensated : t " << double(comp.t) << " error " << double(comp.error) << endl ;
+      cout << "float AB4 : error " << double(ab.error) << " , compensated " << double(abComp.error) << endl ;
+
+      check("compensated time : record at t = 10 (10^5 steps)" , comp.records == 100001 && std::abs(comp.t - 10) < 1.0e-5) ;
+      check("compensated state : RK4 float error / 10" , comp.error < plain.error / 10 && comp.error < 1.0e-6) ;
+      check("compensated state : AB4 float error / 10" , abComp.error < ab.error / 10 && abComp.error < 1.0e-6) ;
+   }
+
+   //-- mixed precision
+   {
+      const auto f = [](const auto , const auto* y , auto* dydt){ dydt[0] = -y[0] / 10 ; } ;
+
+      cout.rdbuf(nullptr) ;
+      RungeKutta4Solver<float>  a(slowDecay<float>(1.0e-4f)) ;
+      RungeKutta4Solver<double> b(slowDecay<double>(1.0e-4)) ;
+      MixedPrecisionRungeKuttaSolver<double , float , RungeKutta4Tableau> m(slowDecay<double>(1.0e-4) , f) ;
+      const Last low = last(a) , high = last(b) , mixed = last(m) ;
+
+      RungeKutta4Solver<long double> c(slowDecay<long double>(1.0e-4L)) ;
+      MixedPrecisionRungeKuttaSolver<long double , double , RungeKutta4Tableau> e(slowDecay<long double>(1.0e-4L) , f) ;
+      const Last extended = last(c) , mixedExtended = last(e) ;
+      cout.rdbuf(console) ;
+
+      cout << "error float " << double(low.error) << " , float / double " << double(mixed.error)
+           << " , double " << double(high.error) << endl ;
+      cout << "error double / long double " << double(mixedExtended.error) << " , long double " << double(extended.error) << endl ;
+
+      check("float / double : error far below float" , mixed.error < low.error / 10 && mixed.error < 1.0e-6) ;
+      check("float / double : rhs counted" , !SolverStats::enabled || m.statistics().rhsEvaluations == b.statistics().rhsEvaluations) ;
+      check("double / long double : error of double stages" , mixedExtended.error < 1.0e-13) ;
+   }
+
+   //-- implicit , adaptive in float
+   {
+      cout.rdbuf(nullptr) ;
+      BDFSolver<float> bdf(slowDecay<float>(1.0e-3f)) ;
+      const Last r = last(bdf) ;
+      cout.rdbuf(console) ;
+
+      check("BDF float : default tolerances of float" , r.t == 10 && r.error < 1.0e-3) ;
+   }
+
+   return testResult() ;
+}
@@ -0,0 +1,223 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <fstream>
+# include <iterator>
+# include <algorithm>
+# include <cstdio>
+# include <cstring>
+# include <cstdint>
+# include <stdexcept>
+# include "rhsODEproblem.H"
+# include "Output/OutputSink.H"
+# include "Output/BinarySink.H"
+# include "Output/DecimatedSink.H"
+# include "Output/AsyncSink.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : output sinks (BinarySink , DecimatedSink , AsyncSink)
+ *
+ *      harmonic oscillator y'' = -y on [0 , 1] , RK4 dt = 1e-3 , the
+ *      records of a direct run kept in memory as the reference
+ *
+ *      - BinarySink : header (magic , version , type , dimension ,
+ *        solver name) , records read back
+ *      - DecimatedSink : every k (the last record always written) ,
+ *        output times (the first record at or after each time)
+ *      - AsyncSink : the file of a BinarySink behind it byte identical
+ *        to the direct one (small blocks , full queue) ; a solve that
+ *        throws , then the same sink reused for a complete solve
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+//-- the records in memory , open() starts a new table
+struct Table
+              : public OutputSink<double>
+{
+   std::string         solver ;
+   std::vector<double> t , u  ;
+   int                 closes = 0 ;
+
+   void open(const std::string_view name , const std::size_t dim) override
+   {
+      OutputSink<double>::open(name , dim) ;
+      solver = name ;
+      t.clear() ;
+      u.clear() ;
+   }
+   void write(const double time , const double* y) override
+   {
+      t.push_back(time) ;
+      u.insert(u.end() , y , y + n) ;
+   }
+   void close() override { closes++ ; }
+};
+
+
+//-- throws from the rhs past t = 0.5 while fail is set
+rhsODEProblem<double> oscillator(const bool& fail)
+{
+   return rhsODEProblem<double>([&fail](const double t , const double* y , double* dydt)
+                                {
+                                   if( fail && t > 0.5 ) throw std::runtime_error("rhs failure") ;
+                                   dydt[0] = y[1] ; dydt[1] = -y[0] ;
+                                } , 0.0 , 1.0 , 1.0e-3 , {1.0 , 0.0}) ;
+}
+
+
+std::vector<char> bytes(const string& filename)
+{
+   std::ifstream in(filename , std::ios::binary) ;
+   return std::vector<char>(std::istreambuf_iterator<char>(in) , std::istreambuf_iterator<char>()) ;
+}
+
+//-- next value of the file (little-endian : the host order here)
+template <typename T>
+T get(const std::vector<char>& b , std::size_t& pos)
+{
+   T value{} ;
+   if( pos + sizeof(T) <= b.size() ) std::memcpy(&value , &b[pos] , sizeof(T)) ;
+   pos += sizeof(T) ;
+   return value ;
+}
+
+
+int main(){
+
+   bool fail = false ;
+   const auto p = oscillator(fail) ;
+
+   Table direct ;
+   {
+      RungeKutta4Solver<double> s(p) ;
+      s.setQuiet(true) ;
+      s.solve(direct) ;
+   }
+   const std::size_t N = direct.t.size() ;
+   check("direct : records and one close" , N >= 1000 && direct.closes == 1 && direct.u.size() == 2*N) ;
+
+   //-- binary file : header , records
+   {
+      {
+         BinarySink<double> out("sinks_direct.out") ;
+         RungeKutta4Solver<double> s(p) ;
+         s.setQuiet(true) ;
+         s.solve(out) ;
+      }
+      const auto b = bytes("sinks_direct.out") ;
+
+      std::size_t pos = 8 ;
+      const bool magic   = b.size() > 8 && std::string(b.data() , 8) == "MGODEBIN" ;
+      const auto version = get<std::uint32_t>(b , pos) ;
+      const auto size    = get<std::uint32_t>(b , pos) ;
+      const auto type    = get<char>(b , pos) ;
+      const auto dim     = get<std::uint64_t>(b , pos) ;
+      const auto length  = get<std::uint32_t>(b , pos) ;
+      const string name  = pos + length <= b.size() ? string(&b[pos] , length) : string() ;
+      pos += length ;
+
+      check("binary : magic , version 1" , magic && version == 1) ;
+      check("binary : sizeof(double) , type 'd' , dimension 2" , size == sizeof(double) && type == 'd' && dim == 2) ;
+      check("binary : solver name" , !name.empty() && name == direct.solver) ;
+      check("binary : N records of 3 values" , b.size() == pos + N * 3 * sizeof(double)) ;
+
+      bool same = true ;
+      for(std::size_t k=0 ; k < N && same ; k++)
+      {
+         const double t = get<double>(b , pos) , y0 = get<double>(b , pos) , y1 = get<double>(b , pos) ;
+         same = t == direct.t[k] && y0 == direct.u[2*k] && y1 == direct.u[2*k+1] ;
+      }
+      check("binary : records read back" , same) ;
+   }
+
+   //-- decimation every k , the last record always written
+   for(const std::size_t k : { std::size_t(7) , std::size_t(10) , std::size_t(1) })
+   {
+      Table kept ;
+      DecimatedSink<double> out(kept , k) ;
+      RungeKutta4Solver<double> s(p) ;
+      s.setQuiet(true) ;
+      s.solve(out) ;
+
+      std::vector<std::size_t> index ;
+      for(std::size_t r=0 ; r < N ; r += k) index.push_back(r) ;
+      if( index.back() != N - 1 ) index.push_back(N - 1) ;
+
+      bool same = kept.t.size() == index.size() ;
+      for(std::size_t j=0 ; j < index.size() && same ; j++)
+         same = kept.t[j] == direct.t[index[j]] && kept.u[2*j+1] == direct.u[2*index[j]+1] ;
+      check("decimated every " + std::to_string(k) + " : records 0 , k , 2k ... and the last" ,
+            same && kept.closes == 1 && kept.solver == direct.solver) ;
+   }
+
+   //-- decimation at output times : first record at or after each time
+   {
+      const std::vector<double> times{ 0.0 , 0.1234 , 0.5004 , 0.5006 , 0.75 , 5.0 } ;
+      Table kept ;
+      DecimatedSink<double> out(kept , times) ;
+      RungeKutta4Solver<double> s(p) ;
+      s.setQuiet(true) ;
+      s.solve(out) ;
+
+      std::vector<std::size_t> index ;
+      for(const double time : times)
+      {
+         const std::size_t r = std::lower_bound(direct.t.begin() , direct.t.end() , time) - direct.t.begin() ;
+         if( r < N && (index.empty() || index.back() != r) ) index.push_back(r) ;
+      }
+
+      bool same = kept.t.size() == index.size() && index.size() == 4 ;       // 0.5004 , 0.5006 : one record , 5 > tf
+      for(std::size_t j=0 ; j < index.size() && same ; j++)
+         same = kept.t[j] == direct.t[index[j]] && kept.u[2*j] == direct.u[2*index[j]] ;
+      check("decimated at times : first record at or after each time" , same) ;
+   }
+
+   //-- asynchronous writer : same bytes as the direct file
+   {
+      {
+         BinarySink<double> file("sinks_async.out") ;
+         AsyncSink<double>  out(file , 64 , 2) ;
+         RungeKutta4Solver<double> s(p) ;
+         s.setQuiet(true) ;
+         s.solve(out) ;
+      }
+      const auto a = bytes("sinks_async.out") , b = bytes("sinks_direct.out") ;
+      check("async : file byte identical to the direct BinarySink" , !a.empty() && a == b) ;
+   }
+
+   //-- asynchronous writer : reused after a solve that threw
+   {
+      Table kept ;
+      AsyncSink<double> out(kept , 16 , 2) ;
+      RungeKutta4Solver<double> s(p) ;
+      s.setQuiet(true) ;
+
+      bool thrown = false ;
+      fail = true ;
+      try { s.solve(out) ; } catch(const std::runtime_error&) { thrown = true ; }
+      fail = false ;
+
+      s.solve(out) ;
+      check("async : the failed solve threw" , thrown) ;
+      check("async : reused , the records of the direct run" , kept.t == direct.t && kept.u == direct.u) ;
+      check("async : one close (the complete solve)" , kept.closes == 1) ;
+   }
+
+   std::remove("sinks_direct.out") ;
+   std::remove("sinks_async.out") ;
+
+   return testResult() ;
+}
@@ -0,0 +1,160 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <chrono>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "SolverStats.H"
+# include "Output/OutputSink.H"
+# include "Euler/ForwardEulerSolver.H"
+# include "Euler/BackwardEulerSolver.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/DormandPrince/DormandPrince5Solver.H"
+# include "RungeKutta/ExplicitRungeKutta/AdaptiveRungeKuttaSolver.H"
+# include "MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton4thSolver.H"
+# include "MultiStep/AdamsMethods/AdaptiveAdamsSolver.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "Benchmark/StiffProblems.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : solver statistics (SolverStats)
+ *
+ *      - the counters against what the method must do
+ *        (rhs per step of the explicit methods , steps = records - 1 ,
+ *         Newton iterations and LU of the implicit ones , PECE Adams) ; the fixed
+ *        step loops take one more step after the last record
+ *      - export : csv lines and json , report after every solve
+ *      - cost of the counters and of the phase timers (RK4 , Lorenz)
+ *
+ *      with -DMG_ODE_NO_STATS every counter stays at 0
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+auto lorenz = [](const double t , const double* y , double* dydt)
+              {
+                 dydt[0] = 10.0 * (y[1] - y[0]) ;
+                 dydt[1] = 28.0 * y[0] - y[1] - y[0] * y[2] ;
+                 dydt[2] = -8.0/3.0 * y[2] + y[0] * y[1] ;
+              };
+
+
+template <typename Solver>
+double timeSolve(Solver& s , const int repeat)
+{
+   NullSink<double> out ;
+   double best = 1.0e30 ;
+   for(int r=0 ; r < repeat ; r++)
+   {
+      const auto start = std::chrono::steady_clock::now();
+      s.solve(out) ;
+      best = std::min(best , std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()) ;
+   }
+   return best ;
+}
+
+
+int main(){
+
+   const rhsODEProblem<double> p(lorenz , 0.0 , 10.0 , 1.0e-3 , {1.0 , 1.0 , 1.0}) ;
+   const auto stiff = vanDerPol() ;
+
+   NullSink<double> out ;
+   SolverStats::csvHeader(cout) ;
+
+   ForwardEulerSolver<double> fe(p) ;
+   fe.solve(out) ;
+   const auto& a = fe.statistics() ;
+   a.writeCsv(cout) ;
+
+   RungeKutta4Solver<double> rk4(p) ;
+   rk4.solve(out) ;
+   const auto& b = rk4.statistics() ;
+   b.writeCsv(cout) ;
+
+   AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> dp5(p) ;
+   dp5.setTolerances(1.0e-8 , 1.0e-8) ;
+   dp5.solve(out) ;
+   const auto& c = dp5.statistics() ;
+   c.writeCsv(cout) ;
+
+   AdamsMoulton4thSolver<double> am4(p) ;
+   am4.solve(out) ;
+   const auto& d = am4.statistics() ;
+   d.writeCsv(cout) ;
+
+   AdaptiveAdamsSolver<double> adams(p) ;
+   adams.setTolerances(1.0e-8 , 1.0e-8) ;
+   adams.solve(out) ;
+   const auto& f = adams.statistics() ;
+   f.writeCsv(cout) ;
+
+   //-- the report sees every run , also the failed ones
+   std::size_t reports = 0 ;
+   BDFSolver<double> bdf(stiff.problem) ;
+   bdf.setTolerances(1.0e-6 , 1.0e-6) ;
+   bdf.setTiming(true) ;
+   bdf.setStatisticsReport([&reports](const SolverStats& s){ reports++ ; s.writeCsv(cout) ; }) ;
+   bdf.solve(out) ;
+   const auto& e = bdf.statistics() ;
+
+   const rhsODEProblem<double> broken([](const double t , const double* y , double* dydt)
+                                      {
+                                         if( t > 0.5 ) throw std::runtime_error(">> rhs out of its domain <<");
+                                         dydt[0] = -y[0] ;
+                                      } , 0.0 , 1.0 , 0.01 , {1.0}) ;
+   BackwardEulerSolver<double> be(broken) ;
+   be.setStatisticsReport([&reports](const SolverStats& s){ reports++ ; s.writeCsv(cout) ; }) ;
+   try { be.solve(out) ; } catch(const std::exception& x) { cout << x.what() << endl ; }
+
+   cout << e << endl ;
+
+   if constexpr( SolverStats::enabled )
+   {
+      check("ForwardEuler : 1 rhs per step , steps = records - 1" ,
+            a.rhsEvaluations == a.records && a.acceptedSteps + 1 == a.records && a.records == 10001) ;
+      check("RungeKutta4 : 4 rhs per step" , b.rhsEvaluations == 4 * b.records) ;
+      check("DormandPrince5 (adaptive) : steps from the controller , fsal" ,
+            c.acceptedSteps == dp5.accepted() && c.rejectedSteps == dp5.rejected() &&
+            c.rhsEvaluations <= 6 * (c.acceptedSteps + c.rejectedSteps) + 2) ;
+      check("AdamsMoulton4 : Newton iterations and LU counted" ,
+            d.nonlinearSolves > 0 && d.newtonIterations == am4.nonlinearSolver().iterations &&
+            d.factorizations == am4.nonlinearSolver().factorizations && d.newtonFailures == 0) ;
+      check("AdaptiveAdams : 2 rhs per accepted step , 1 per rejected" ,
+            f.acceptedSteps == adams.accepted() && f.rejectedSteps == adams.rejected() &&
+            f.rhsEvaluations == 1 + 2 * f.acceptedSteps + f.rejectedSteps) ;
+      check("BDF : Jacobians , LU , timers" ,
+            e.jacobianEvaluations == bdf.nonlinearSolver().jacobians && e.factorizations > 0 &&
+            e.rhsTime > 0 && e.linearAlgebraTime > 0 && e.totalTime >= e.rhsTime) ;
+      check("BackwardEuler : failed run reported" ,
+            be.statistics().failed && be.statistics().nonlinearSolves == 49 && reports == 2) ;
+      check("statistics reset by the next solve" ,
+            (rk4.solve(out) , rk4.statistics().rhsEvaluations == 4 * rk4.statistics().records)) ;
+   }
+   else
+      check("compiled out : no counter" , a.rhsEvaluations == 0 && e.rhsEvaluations == 0 && reports == 0) ;
+
+   //-- overhead : RungeKutta4 on Lorenz , 10^4 steps
+   {
+      std::streambuf* console = cout.rdbuf(nullptr) ;
+      RungeKutta4Solver<double> s(p) ;
+      const double counters = timeSolve(s , 20) ;
+      s.setTiming(true) ;
+      const double timers = timeSolve(s , 20) ;
+      cout.rdbuf(console) ;
+      cout << "RungeKutta4 Lorenz 1e4 steps : counters " << counters*1e3 << " ms , with phase timers "
+           << timers*1e3 << " ms" << endl ;
+   }
+
+   return testResult() ;
+}
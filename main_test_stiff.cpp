@@ -0,0 +1,135 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "Benchmark/StiffProblems.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "RungeKutta/TRBDF2/TRBDF2Solver.H"
+# include "RungeKutta/SDIRK/SDIRK4Solver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : stiff solvers , DiagonallyImplicitRungeKuttaSolver
+ *             (TR-BDF2 , SDIRK4) and variable order BDF
+ *
+ *      - Robertson and HIRES (Benchmark/StiffProblems.H) : error at tf
+ *        against the reference , |u - ref| / (tol (1 + |ref|)) below a
+ *        bound at rtol = atol = 1e-6 and 1e-8
+ *      - dense output at setOutputTimes : y' = -1000 (y - cos t) - sin t ,
+ *        z' = -z , exact cos t and exp(-t) at the requested times
+ *      - a Newton failure halves the step : the rhs is NaN past t = 0.3
+ *        until the first step is accepted , dt = 1 --> first record at
+ *        t = 0.25 after two failures
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+//-- max error at tf in units of the tolerance : |u_i - ref_i| / (tol (1 + |ref_i|))
+template <typename Solver>
+double referenceError(const StiffProblem& p , const double tol , std::size_t& steps)
+{
+   Solver s(p.problem) ;
+   s.setTolerances(tol , tol) ;
+   s.setQuiet(true) ;
+   const auto last = finalState(s) ;
+   steps = s.accepted() ;
+
+   if( last.size() != p.reference.size() ) return 1.0e30 ;
+   double err = 0 ;
+   for(std::size_t i=0 ; i < last.size() ; i++)
+      err = std::max(err , std::abs(last[i] - p.reference[i]) / (tol * (1 + std::abs(p.reference[i])))) ;
+   return err ;
+}
+
+
+template <typename Solver>
+void stiffSet(const string& name , const double bound)
+{
+   for(const auto& p : { robertson() , hires() })
+   {
+      std::size_t s6 , s8 ;
+      const double e6 = referenceError<Solver>(p , 1.0e-6 , s6) ;
+      const double e8 = referenceError<Solver>(p , 1.0e-8 , s8) ;
+      cout << name << " " << p.name << " : error / tol " << e6 << " (tol 1e-6 , " << s6 << " steps) , "
+                                                        << e8 << " (tol 1e-8 , " << s8 << " steps)" << endl ;
+
+      check(name + " " + p.name + " : error < " + std::to_string(int(bound)) + " tol" , e6 < bound && e8 < bound) ;
+      check(name + " " + p.name + " : tighter tol , more steps" , s8 > s6) ;
+   }
+}
+
+
+template <typename Solver>
+void denseOutput(const string& name , const double tol , const double bound)
+{
+   Solver s(rhsODEProblem<double>([](const double t , const double* y , double* dydt)
+                                  { dydt[0] = -1000 * (y[0] - std::cos(t)) - std::sin(t) ; dydt[1] = -y[1] ; } ,
+                                  0.0 , 3.0 , 1.0e-4 , {1.0 , 1.0})) ;
+   s.setTolerances(tol , tol) ;
+   s.setOutputTimes({0.0 , 0.3 , 1.7 , 2.25 , 2.9 , 3.0}) ;
+   s.setQuiet(true) ;
+
+   std::vector<double> times ;
+   double error = 0 ;
+   s.observe([&](const double t , const double* y , const std::size_t)
+             {
+                times.push_back(t) ;
+                error = std::max({error , std::abs(y[0] - std::cos(t)) , std::abs(y[1] - std::exp(-t))}) ;
+             }) ;
+   cout << name << " dense output : error " << error << " , " << s.accepted() << " steps" << endl ;
+
+   check(name + " : dense output at the requested times" ,
+         times == std::vector<double>{0.0 , 0.3 , 1.7 , 2.25 , 2.9 , 3.0} && error < bound * tol) ;
+}
+
+
+template <typename Solver>
+void newtonFailure(const string& name)
+{
+   bool   poisoned = true ;
+   double first    = 0 ;
+
+   Solver s(rhsODEProblem<double>([&poisoned](const double t , const double* y , double* dydt)
+                                  { dydt[0] = poisoned && t > 0.3 ? std::nan("") : -y[0] ; } ,
+                                  0.0 , 2.0 , 1.0 , {1.0})) ;
+   s.setTolerances(1.0e-1 , 1.0e-1) ;
+   s.setQuiet(true) ;
+   s.observe([&](const double t , const double* , const std::size_t)
+             {
+                if( t > 0 && poisoned ) { first = t ; poisoned = false ; }
+             }) ;
+
+   cout << name << " Newton failure : first step " << first << " , " << s.rejected() << " rejected" << endl ;
+   check(name + " : a Newton failure halves the step (1 , 0.5 , 0.25)" , first == 0.25 && s.rejected() >= 2) ;
+}
+
+
+int main(){
+
+   stiffSet<TRBDF2Solver<double>>("TR-BDF2" , 200) ;        // second order : more global error
+   stiffSet<SDIRK4Solver<double>>("SDIRK4"  , 50) ;
+   stiffSet<BDFSolver<double>>   ("BDF"     , 50) ;
+
+   denseOutput<TRBDF2Solver<double>>("TR-BDF2" , 1.0e-8 , 200) ;
+   denseOutput<SDIRK4Solver<double>>("SDIRK4"  , 1.0e-8 , 100) ;
+   denseOutput<BDFSolver<double>>   ("BDF"     , 1.0e-8 , 100) ;
+
+   newtonFailure<TRBDF2Solver<double>>("TR-BDF2") ;
+   newtonFailure<SDIRK4Solver<double>>("SDIRK4") ;
+   newtonFailure<BDFSolver<double>>   ("BDF") ;
+
+   return testResult() ;
+}
@@ -0,0 +1,152 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <cmath>
+# include <memory>
+# include <valarray>
+# include "Output/OutputSink.H"
+# include "Symplectic/PartitionedProblem.H"
+# include "Symplectic/StormerVerletSolver.H"
+# include "Symplectic/YoshidaSolver.H"
+# include "Symplectic/ForestRuthSolver.H"
+# include "Symplectic/EnergyDriftSink.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : symplectic solvers on the Kepler problem (e = 0.5)
+ *
+ *      - order of every splitting method (error after one period ,
+ *        h and h/2)
+ *      - energy error bounded over 1000 periods , no drift , while
+ *        RK4 with the same force evaluations drifts linearly
+ *      - force evaluations and steps in the statistics , t_i = t0 + i h
+ *      - owned problem (temporary) and the same problem through RK4
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+const double pi = 3.14159265358979323846 ;
+const double e  = 0.5 ;                       // eccentricity , period 2 pi
+
+
+PartitionedProblem<double> kepler(const double tf , const double dt)
+{
+   PartitionedProblem<double> p([](const double t , const double* q , double* f)
+                                {
+                                   const double r  = std::sqrt(q[0]*q[0] + q[1]*q[1]) ;
+                                   const double r3 = r*r*r ;
+                                   f[0] = -q[0]/r3 ;
+                                   f[1] = -q[1]/r3 ;
+                                } ,
+                                0.0 , tf , dt , {1.0 - e , 0.0} , {0.0 , std::sqrt((1.0 + e)/(1.0 - e))}) ;
+
+   p.setEnergy([](const double* q , const double* p)
+               { return 0.5*(p[0]*p[0] + p[1]*p[1]) - 1.0/std::sqrt(q[0]*q[0] + q[1]*q[1]) ; }) ;
+   return p ;
+}
+
+
+//-- position error after one period (exact : back to q0)
+template <typename Solver>
+double periodError(const int stepsPerPeriod)
+{
+   const auto p = kepler(2*pi , 2*pi/stepsPerPeriod) ;
+   Solver s(p) ;
+
+   double x = 0 , y = 0 ;
+   s.observe([&](const double t , const double* u , const std::size_t n){ x = u[0] ; y = u[1] ; }) ;
+   return std::hypot(x - (1.0 - e) , y) ;
+}
+
+
+template <typename Solver>
+void order(const string& name)
+{
+   const double e1 = periodError<Solver>(200) ;
+   const double e2 = periodError<Solver>(400) ;
+   const double q  = std::log2(e1/e2) ;
+
+   cout << setw(16) << name << "  error " << setw(14) << e1 << setw(14) << e2
+        << "  order " << fixed << setprecision(2) << q << scientific << setprecision(6) << endl ;
+   check(name + " : order " + to_string(Solver::order()) , std::abs(q - Solver::order()) < 0.2) ;
+}
+
+
+//-- energy error over periods
+template <typename Solver>
+EnergyDriftSink<double> energy(const PartitionedProblem<double>& p)
+{
+   Solver s(p) ;
+   EnergyDriftSink<double> out(p) ;
+   s.solve(out) ;
+   return out ;
+}
+
+
+int main()
+{
+   cout << scientific << setprecision(6) ;
+
+   order<StormerVerletSolver<double>>("StormerVerlet") ;
+   order<Yoshida4Solver<double>>     ("Yoshida4") ;
+   order<Yoshida6Solver<double>>     ("Yoshida6") ;
+   order<ForestRuthSolver<double>>   ("ForestRuth") ;
+   order<PEFRLSolver<double>>        ("PEFRL") ;
+
+
+   //-- 100 and 1000 periods , 200 steps per period ; RK4 takes 4 forces per step as PEFRL
+   const auto shortRun = kepler(100*2*pi  , 2*pi/200) ;
+   const auto longRun  = kepler(1000*2*pi , 2*pi/200) ;
+
+   const auto sv1 = energy<StormerVerletSolver<double>>(shortRun) , sv2 = energy<StormerVerletSolver<double>>(longRun) ;
+   const auto pf1 = energy<PEFRLSolver<double>>(shortRun)         , pf2 = energy<PEFRLSolver<double>>(longRun) ;
+   const auto rk1 = energy<RungeKutta4Solver<double>>(shortRun)   , rk2 = energy<RungeKutta4Solver<double>>(longRun) ;
+
+   cout << setw(16) << "" << setw(14) << "max 100" << setw(14) << "max 1000" << setw(14) << "drift" << endl ;
+   cout << setw(16) << "StormerVerlet" << setw(14) << sv1.maxError() << setw(14) << sv2.maxError() << setw(14) << sv2.drift() << endl ;
+   cout << setw(16) << "PEFRL"         << setw(14) << pf1.maxError() << setw(14) << pf2.maxError() << setw(14) << pf2.drift() << endl ;
+   cout << setw(16) << "RungeKutta4"   << setw(14) << rk1.maxError() << setw(14) << rk2.maxError() << setw(14) << rk2.drift() << endl ;
+
+   check("StormerVerlet : energy error bounded" , sv2.maxError() < 1.1 * sv1.maxError()) ;
+   check("PEFRL : energy error bounded"         , pf2.maxError() < 1.1 * pf1.maxError()) ;
+   check("PEFRL : no drift"                     , std::abs(pf2.drift()) * longRun.tf() < 1e-2 * pf2.maxError()) ;
+   check("RungeKutta4 : energy drifts"          , rk2.maxError() > 5 * rk1.maxError()) ;
+   check("PEFRL beats RungeKutta4 over 1000 periods" , pf2.maxError() < 1e-2 * rk2.maxError()) ;
+
+
+   //-- counters , records at t0 + i h
+   {
+      Yoshida6Solver<double> s(shortRun) ;
+      std::size_t records = 0 ;
+      double      last    = 0 ;
+      s.observe([&](const double t , const double* u , const std::size_t n){ records++ ; last = t ; }) ;
+
+      const auto& st = s.statistics() ;
+      check("Yoshida6 : 7 forces per step , steps = records - 1" ,
+            !SolverStats::enabled || ( st.rhsEvaluations == 7 * s.steps() && st.acceptedSteps == s.steps() )) ;
+      check("Yoshida6 : 20000 steps , last record at tf" ,
+            records == 20001 && s.steps() == 20000 && std::abs(last - shortRun.tf()) < 1e-12 * shortRun.tf()) ;
+   }
+
+
+   //-- owned problem (moved in , not sliced) , shared
+   {
+      StormerVerletSolver<double> owned(kepler(2*pi , 2*pi/200)) ;
+      StormerVerletSolver<double> shared(std::make_shared<const PartitionedProblem<double>>(kepler(2*pi , 2*pi/200))) ;
+      const auto a = owned.trajectory() ;
+      const auto b = shared.trajectory() ;
+      check("owned / shared problem" , a(a.size()-1 , 0) == b(b.size()-1 , 0)) ;
+   }
+
+   return testResult() ;
+}
@@ -0,0 +1,93 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <cmath>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "RungeKutta/ExplicitRungeKutta/ExplicitRungeKuttaSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : empirical order of the Butcher tableaux
+ *             (ButcherTableau.H , ExplicitRungeKuttaSolver)
+ *
+ *      forced oscillator y'' + y = cos 2t , y(0) = 1 , y'(0) = 0 ,
+ *      exact y = 4/3 cos t - 1/3 cos 2t (the forcing checks the nodes c)
+ *
+ *      log2 of the error ratio at t = 2 with h and h/2 , for the ten
+ *      tableaux , run time size (N = 0) and compile time size (N = 2) :
+ *      within 0.4 of Tableau::order , the same records for both N
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+const double tf = 2.0 ;
+
+//-- max error on the record at t = tf , the last state in y
+template <typename Solver>
+double finalError(const double h , double* y)
+{
+   Solver s(rhsODEProblem<double>([](const double t , const double* u , double* dudt)
+                                  { dudt[0] = u[1] ; dudt[1] = -u[0] + std::cos(2*t) ; } ,
+                                  0.0 , tf + h/4 , h , {1.0 , 0.0})) ;
+   s.setQuiet(true) ;
+
+   double error = -1 ;
+   s.observe([&](const double t , const double* u , const std::size_t)
+             {
+                if( std::abs(t - tf) > 1.0e-9 ) return ;
+                y[0]  = u[0] ;  y[1] = u[1] ;
+                error = std::max(std::abs(u[0] - (4*std::cos(t) - std::cos(2*t))/3) ,
+                                 std::abs(u[1] - (-4*std::sin(t) + 2*std::sin(2*t))/3)) ;
+             }) ;
+   return error ;
+}
+
+
+template <typename Tableau>
+void order(const double h)
+{
+   double y0[2] , y2[2] , dummy[2] ;
+
+   const double ec = finalError<ExplicitRungeKuttaSolver<double , Tableau>>(h   , dummy) ;
+   const double ef = finalError<ExplicitRungeKuttaSolver<double , Tableau>>(h/2 , y0) ;
+   const double p  = ec > 0 && ef > 0 ? std::log2(ec / ef) : 0 ;
+
+   const double cc = finalError<ExplicitRungeKuttaSolver<double , Tableau , 2>>(h   , dummy) ;
+   const double cf = finalError<ExplicitRungeKuttaSolver<double , Tableau , 2>>(h/2 , y2) ;
+   const double q  = cc > 0 && cf > 0 ? std::log2(cc / cf) : 0 ;
+
+   cout << setw(32) << left << Tableau::name << right << " order " << Tableau::order
+        << " : N = 0 " << setw(6) << setprecision(3) << p << " , N = 2 " << setw(6) << q << setprecision(6) << endl ;
+
+   const string name = Tableau::name ;
+   check(name + " : order (N = 0)" , std::abs(p - Tableau::order) < 0.4) ;
+   check(name + " : order (N = 2)" , std::abs(q - Tableau::order) < 0.4) ;
+   check(name + " : N = 2 ~ N = 0" , std::abs(y2[0] - y0[0]) < 1.0e-12 && std::abs(y2[1] - y0[1]) < 1.0e-12) ;
+}
+
+
+int main(){
+
+   order<ForwardEulerTableau>        (0.01) ;
+   order<HeunTableau>                (0.02) ;
+   order<ModifiedEulerTableau>       (0.02) ;
+   order<RungeKutta4Tableau>         (0.1) ;
+   order<RungeKuttaMersonTableau>    (0.1) ;
+   order<RungeKuttaFehlberg45Tableau>(0.1) ;
+   order<RungeKuttaFehlberg5Tableau> (0.1) ;
+   order<DormandPrince5Tableau>      (0.1) ;
+   order<Tsitouras5Tableau>          (0.1) ;
+   order<Verner6Tableau>             (0.2) ;
+
+   return testResult() ;
+}
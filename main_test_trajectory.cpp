@@ -0,0 +1,172 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <cmath>
+# include <algorithm>
+# include "rhsODEproblem.H"
+# include "Output/ObserverSink.H"
+# include "Output/Trajectory.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/ExplicitRungeKutta/AdaptiveRungeKuttaSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : records in memory (Trajectory , TrajectorySink ,
+ *             ObserverSink , OdeSolver::trajectory)
+ *
+ *      - Trajectory : push_back beyond the capacity (chunks of 1024
+ *        records , then cap/2) , reserve keeps the records ,
+ *        component(i) stride 1 , state(k) stride capacity , assign
+ *      - TrajectorySink : storage reserved at open() from the hint
+ *      - trajectory() against an ObserverSink run , record by record ,
+ *        more than 1024 records : fixed step RK4 (preallocated from Ns ,
+ *        no growth) and adaptive DP5(4) (no hint , chunked growth)
+ *
+ *      exit code 1 if a check fails
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+//-- y0'' = -y0 , y2' = -y2 , y3' = y0 : 4 components
+rhsODEProblem<double> problem(const double tf , const double dt)
+{
+   return rhsODEProblem<double>([](const double , const double* y , double* dydt)
+                                { dydt[0] = y[1] ; dydt[1] = -y[0] ; dydt[2] = -y[2] ; dydt[3] = y[0] ; } ,
+                                0.0 , tf , dt , {1.0 , 0.0 , 1.0 , 0.0}) ;
+}
+
+
+struct Records
+{
+   std::vector<double> t , u ;
+   std::size_t         n = 0 ;
+};
+
+template <typename Solver>
+Records records(Solver& s)
+{
+   Records r ;
+   ObserverSink<double> out([&r](const double t , const double* u , const std::size_t n)
+                            { r.n = n ; r.t.push_back(t) ; r.u.insert(r.u.end() , u , u + n) ; }) ;
+   s.solve(out) ;
+   return r ;
+}
+
+//-- every record through time() , state(k) and component(i)
+bool sameRecords(const Trajectory<double>& tr , const Records& r)
+{
+   if( tr.size() != r.t.size() || tr.dimension() != r.n || tr.empty() )
+      return false ;
+
+   for(std::size_t k=0 ; k < tr.size() ; k++)
+   {
+      const auto x = tr.state(k) ;
+      if( tr.time(k) != r.t[k] || tr.times()[k] != r.t[k] || x.size() != r.n || x.stride() != tr.capacity() )
+         return false ;
+      for(std::size_t i=0 ; i < r.n ; i++)
+         if( x[i] != r.u[k*r.n + i] || tr.component(i)[k] != r.u[k*r.n + i] || tr(k , i) != r.u[k*r.n + i] )
+            return false ;
+   }
+   return true ;
+}
+
+
+int main(){
+
+   //-- storage
+   {
+      const std::size_t n = 3 ;
+      auto value = [](const std::size_t k , const std::size_t i){ return 10.0 * k + i ; };
+
+      Trajectory<double> tr(n) ;
+      std::vector<std::size_t> capacities ;
+      double u[n] ;
+      for(std::size_t k=0 ; k < 2500 ; k++)
+      {
+         for(std::size_t i=0 ; i < n ; i++) u[i] = value(k , i) ;
+         if( k == 0 || tr.size() == tr.capacity() ) capacities.push_back(tr.capacity()) ;
+         tr.push_back(0.5 * k , u) ;
+      }
+      capacities.push_back(tr.capacity()) ;
+
+      bool stored = tr.size() == 2500 ;
+      for(std::size_t k=0 ; k < tr.size() && stored ; k++)
+         for(std::size_t i=0 ; i < n ; i++)
+            stored = stored && tr.time(k) == 0.5 * k && tr(k , i) == value(k , i) &&
+                               tr.state(k)[i] == value(k , i) && tr.component(i)[k] == value(k , i) ;
+
+      check("push_back : capacity 0 , 1024 , 2048 , 3072 (chunks)" , capacities == std::vector<std::size_t>{0 , 1024 , 2048 , 3072}) ;
+      check("push_back : 2500 records through the growths" , stored) ;
+      check("views : component stride 1 , state stride capacity" ,
+            tr.component(2).stride() == 1 && tr.component(2).size() == 2500 &&
+            tr.state(7).stride() == tr.capacity() && tr.state(7).size() == n) ;
+
+      tr.reserve(5000) ;
+      bool kept = tr.capacity() == 5000 ;
+      for(std::size_t k=0 ; k < tr.size() && kept ; k++)
+         kept = tr(k , 0) == value(k , 0) && tr(k , n-1) == value(k , n-1) && tr.state(k)[1] == value(k , 1) ;
+      check("reserve : records kept in the wider storage" , kept && tr.size() == 2500) ;
+
+      tr.reserve(100) ;
+      check("reserve : smaller than the capacity , nothing changes" , tr.capacity() == 5000) ;
+
+      tr.assign(n) ;
+      check("assign : same dimension , capacity kept , no record" , tr.empty() && tr.capacity() == 5000) ;
+      tr.assign(2) ;
+      check("assign : new dimension , storage dropped" , tr.empty() && tr.capacity() == 0 && tr.dimension() == 2) ;
+
+      Trajectory<double> pre(4 , 600) ;
+      check("constructor : records reserved" , pre.capacity() == 600 && pre.empty()) ;
+   }
+
+   //-- sink : reserved at open
+   {
+      Trajectory<double> tr ;
+      TrajectorySink<double> out(tr , 1500) ;
+      out.open("test" , 2) ;
+      const double u[2] = { 1.0 , 2.0 } ;
+      out.write(0.25 , u) ;
+      out.close() ;
+      check("TrajectorySink : hint reserved at open()" , tr.capacity() == 1500 && tr.dimension() == 2 &&
+                                                         tr.size() == 1 && tr(0 , 1) == 2.0) ;
+   }
+
+   //-- fixed step : trajectory() = observer records , no growth
+   {
+      RungeKutta4Solver<double> s(problem(3.0 , 1.0e-3)) ;
+      s.setQuiet(true) ;
+      const Records r = records(s) ;
+      const auto tr = s.trajectory() ;
+
+      cout << "RK4 : " << tr.size() << " records , capacity " << tr.capacity() << " , expected " << s.expectedRecords() << endl ;
+      check("RK4 : more than 1024 records" , tr.size() > 1024) ;
+      check("RK4 : trajectory() = ObserverSink , record by record" , sameRecords(tr , r)) ;
+      check("RK4 : preallocated from Ns , no growth" , tr.capacity() == s.expectedRecords() && tr.capacity() >= tr.size()) ;
+   }
+
+   //-- adaptive : no hint , chunked growth
+   {
+      AdaptiveRungeKuttaSolver<double , DormandPrince5Tableau> s(problem(20.0 , 0.01)) ;
+      s.setTolerances(1.0e-12 , 1.0e-12) ;
+      s.setQuiet(true) ;
+      const Records r = records(s) ;
+      const auto tr = s.trajectory() ;
+
+      cout << "DP5(4) : " << tr.size() << " records , capacity " << tr.capacity() << endl ;
+      check("DP5(4) : more than 1024 records" , tr.size() > 1024) ;
+      check("DP5(4) : trajectory() = ObserverSink , record by record" , sameRecords(tr , r)) ;
+      std::size_t grown = 0 ;                                     // 0 , 1024 , 2048 , 3072 , 4608 ...
+      while( grown < tr.size() ) grown += std::max(Trajectory<double>::chunk , grown/2) ;
+      check("DP5(4) : no hint , storage grown in chunks" , s.expectedRecords() == 0 && tr.capacity() == grown) ;
+   }
+
+   return testResult() ;
+}
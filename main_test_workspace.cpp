@@ -0,0 +1,189 @@
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <cstdlib>
+# include <new>
+# include <memory>
+# include "rhsODEproblem.H"
+# include "Workspace.H"
+# include "Output/OutputSink.H"
+# include "Euler/ForwardEulerSolver.H"
+# include "Euler/BackwardEulerSolver.H"
+# include "RungeKutta/RungeKutta4th/RungeKutta4Solver.H"
+# include "RungeKutta/DormandPrince/DormandPrince5Solver.H"
+# include "RungeKutta/CrankNicholson/CrankNicholsonSolver.H"
+# include "RungeKutta/TRBDF2/TRBDF2Solver.H"
+# include "MultiStep/LeapFrogSolver.H"
+# include "MultiStep/AdamsMethods/AdamsBashforth/AdamsBashforth4thSolver.H"
+# include "MultiStep/AdamsMethods/AdamsMoulton/AdamsMoulton4thSolver.H"
+# include "MultiStep/AdamsMethods/AdaptiveAdamsSolver.H"
+# include "MultiStep/BDF/BDFSolver.H"
+# include "Symplectic/StormerVerletSolver.H"
+# include "Symplectic/YoshidaSolver.H"
+# include "TestCheck.H"
+
+using namespace std;
+using namespace mg::numeric::odesystem ;
+
+
+/*------------------------------------------------------------------
+ *
+ *      Test : heap allocations of repeated solves
+ *
+ *      every operator new is counted , the records go to a NullSink :
+ *
+ *      - same solver , solve() again            --> no allocation
+ *      - new solver on a warm Workspace ,
+ *        construction + solve() + destruction  --> no allocation
+ *        (fixed step explicit , multistep and symplectic solvers , the
+ *         implicit ones keep their Newton matrices per instance)
+ *
+ *      exit code 1 if an allocation is found
+ *
+ *      @Marco Ghiani Glasgow
+ *
+ -----------------------------------------------------------------*/
+
+
+static std::size_t allocations = 0 ;
+
+//-- the whole replaceable set on malloc / free (plain , array , sized , aligned) :
+//   g++ -Wmismatched-new-delete takes free() inside a replaced operator delete
+//   for a mismatch with new , a false positive here
+# if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+# endif
+
+static void* counted(const std::size_t size , const std::size_t alignment = 0)
+{
+   allocations++ ;
+   const std::size_t bytes = size ? size : 1 ;
+   void* p = alignment ? std::aligned_alloc(alignment , (bytes + alignment - 1) / alignment * alignment)
+                       : std::malloc(bytes) ;
+   if( !p ) throw std::bad_alloc() ;
+   return p ;
+}
+
+void* operator new  (std::size_t size)                          { return counted(size) ; }
+void* operator new[](std::size_t size)                          { return counted(size) ; }
+void* operator new  (std::size_t size , std::align_val_t a)     { return counted(size , static_cast<std::size_t>(a)) ; }
+void* operator new[](std::size_t size , std::align_val_t a)     { return counted(size , static_cast<std::size_t>(a)) ; }
+
+void operator delete  (void* p) noexcept                                      { std::free(p) ; }
+void operator delete[](void* p) noexcept                                      { std::free(p) ; }
+void operator delete  (void* p , std::size_t) noexcept                        { std::free(p) ; }
+void operator delete[](void* p , std::size_t) noexcept                        { std::free(p) ; }
+void operator delete  (void* p , std::align_val_t) noexcept                   { std::free(p) ; }
+void operator delete[](void* p , std::align_val_t) noexcept                   { std::free(p) ; }
+void operator delete  (void* p , std::size_t , std::align_val_t) noexcept     { std::free(p) ; }
+void operator delete[](void* p , std::size_t , std::align_val_t) noexcept     { std::free(p) ; }
+
+# if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+# endif
+
+
+//-- damped oscillator + decay , 3 equations
+auto oscillator = [](const double t , const double* y , double* dydt)
+                  {
+                     dydt[0] =  y[1] ;
+                     dydt[1] = -y[0] - 0.15*y[1] ;
+                     dydt[2] = -y[2] ;
+                  };
+
+
+void report(const string& name , const string& run , const std::size_t count)
+{
+   check(name + " : " + run + " , " + std::to_string(count) + " new" , count == 0) ;
+}
+
+
+//-- solve twice , count the second one
+template <typename Solver , typename Problem>
+void sameSolver(const string& name , const Problem& p ,
+                const std::shared_ptr<Workspace<double>>& ws)
+{
+   Solver s(p) ;
+   s.setWorkspace(ws) ;
+   NullSink<double> out ;
+   s.solve(out) ;
+
+   const std::size_t before = allocations ;
+   s.solve(out) ;
+   report(name , "solve() again" , allocations - before) ;
+}
+
+
+//-- warm the workspace , then count construction + solve + destruction
+template <typename Solver , typename Problem>
+void newSolver(const string& name , const Problem& p ,
+               const std::shared_ptr<Workspace<double>>& ws)
+{
+   NullSink<double> out ;
+   {
+      Solver s(p) ;
+      s.setWorkspace(ws) ;
+      s.solve(out) ;
+   }
+
+   const std::size_t before = allocations ;
+   {
+      Solver s(p) ;
+      s.setWorkspace(ws) ;
+      s.solve(out) ;
+   }
+   report(name , "new solver , warm workspace" , allocations - before) ;
+}
+
+
+int main()
+{
+   const rhsODEProblem<double> p1(oscillator , 0.0 , 20.0 , 0.01 , {1.0 , 0.0 , 1.0}) ;
+
+   auto ws = std::make_shared<Workspace<double>>(p1.size()) ;
+
+   sameSolver<ForwardEulerSolver<double>>      ("ForwardEuler"   , p1 , ws) ;
+   sameSolver<BackwardEulerSolver<double>>     ("BackwardEuler"  , p1 , ws) ;
+   sameSolver<RungeKutta4Solver<double>>       ("RungeKutta4"    , p1 , ws) ;
+   sameSolver<DormandPrince5Solver<double>>    ("DormandPrince5" , p1 , ws) ;
+   sameSolver<CrankNicholsonSolver<double>>    ("CrankNicholson" , p1 , ws) ;
+   sameSolver<TRBDF2Solver<double>>            ("TR-BDF2"        , p1 , ws) ;
+   sameSolver<LeapFrogSolver<double>>          ("LeapFrog"       , p1 , ws) ;
+   sameSolver<AdamsBashforth4thSolver<double>> ("AdamsBashforth4", p1 , ws) ;
+   sameSolver<AdamsMoulton4thSolver<double>>   ("AdamsMoulton4"  , p1 , ws) ;
+   sameSolver<AdaptiveAdamsSolver<double>>     ("AdaptiveAdams"  , p1 , ws) ;
+   sameSolver<BDFSolver<double>>               ("BDF"            , p1 , ws) ;
+
+   newSolver<ForwardEulerSolver<double>>       ("ForwardEuler"   , p1 , ws) ;
+   newSolver<RungeKutta4Solver<double>>        ("RungeKutta4"    , p1 , ws) ;
+   newSolver<LeapFrogSolver<double>>           ("LeapFrog"       , p1 , ws) ;
+   newSolver<AdamsBashforth4thSolver<double>>  ("AdamsBashforth4", p1 , ws) ;
+
+   cout << "workspace : dimension " << ws->dimension() << " , buffers " << ws->size()
+        << " , idle " << ws->available() << endl ;
+
+   //-- symplectic solvers , q'' = -q in 2 d (state [ q ; p ] of 4 values)
+   const PartitionedProblem<double> p2([](const double t , const double* q , double* f)
+                                       { f[0] = -q[0] ; f[1] = -q[1] ; } ,
+                                       0.0 , 20.0 , 0.01 , {1.0 , 0.0} , {0.0 , 1.0}) ;
+
+   auto ws2 = std::make_shared<Workspace<double>>(p2.size()) ;
+
+   sameSolver<StormerVerletSolver<double>>     ("StormerVerlet"  , p2 , ws2) ;
+   sameSolver<Yoshida6Solver<double>>          ("Yoshida6"       , p2 , ws2) ;
+   newSolver<StormerVerletSolver<double>>      ("StormerVerlet"  , p2 , ws2) ;
+   newSolver<Yoshida6Solver<double>>           ("Yoshida6"       , p2 , ws2) ;
+
+   //-- problem held by shared pointer and moved in (temporary)
+   auto shared = std::make_shared<rhsODEProblem<double>>(oscillator , 0.0 , 1.0 , 0.01 , std::valarray<double>{1.0 , 0.0 , 1.0}) ;
+   RungeKutta4Solver<double> byShared(shared) ;
+   RungeKutta4Solver<double> byValue(rhsODEProblem<double>(oscillator , 0.0 , 1.0 , 0.01 , {1.0 , 0.0 , 1.0})) ;
+   const auto a = byShared.trajectory() ;
+   const auto b = byValue.trajectory() ;
+   cout << "shared / owned problem , x(1) " << a(a.size()-1 , 0) << " " << b(b.size()-1 , 0) << endl ;
+
+   if( a(a.size()-1 , 0) != b(b.size()-1 , 0) ) failures++ ;
+
+   return testResult() ;
+}